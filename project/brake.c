@@ -0,0 +1,500 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file brake.c
+ *
+ * @brief This module implements the controlled stop with a deceleration ramp
+ * and a short circuit or DC injection final stage, the limitation of the
+ * regenerative current by the DC bus voltage and the brake chopper control.
+ *
+ * Component: CONTROLLED STOP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "brake.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+#include "thermal.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Speed at which the final stage starts */
+#define BRAKE_FINAL_SPEED       (int16_t)(BRAKE_FINAL_SPEED_RPM*POLE_PAIRS)
+/* Speed reference decrease per control cycle, with 16 fractional bits */
+#define BRAKE_DECEL_STEP        (int32_t)(65536.0*MAXIMUMSPEED_ELECTR* \
+                                    LOOPTIME_SEC/BRAKE_DECEL_TIME_SEC)
+/* Longest deceleration, the final stage starts also if the motor did not
+   follow the ramp */
+#define BRAKE_DECEL_COUNT       (uint16_t)(BRAKE_DECEL_TIME_SEC/LOOPTIME_SEC)
+/* Duration of the final stage */
+#define BRAKE_FINAL_COUNT       (uint16_t)(BRAKE_FINAL_TIME_SEC/LOOPTIME_SEC)
+
+/* Regenerative current limitation range */
+#define BRAKE_REGEN_START       Q15(BRAKE_REGEN_LIMIT_START/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+#define BRAKE_REGEN_END         Q15(BRAKE_REGEN_LIMIT_END/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+/* Regenerative current weight decrease per bus voltage unit, with 8 more
+   fractional bits */
+#define BRAKE_REGEN_SLOPE       (int16_t)(32768.0*256.0/(BRAKE_REGEN_END - \
+                                    BRAKE_REGEN_START))
+
+/* Brake chopper switching levels */
+#define BRAKE_CHOPPER_ON_LEVEL  Q15(BRAKE_CHOPPER_ON/DC_BUS_VOLTAGE_FULL_SCALE)
+#define BRAKE_CHOPPER_OFF_LEVEL Q15(BRAKE_CHOPPER_OFF/DC_BUS_VOLTAGE_FULL_SCALE)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+BRAKE_PARM_T brakeParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitBrakeParams()
+
+  Summary:
+    Initializes controlled stop parameters
+
+  Description:
+    This routine initializes the regenerative current limit without
+    limitation and the brake chopper off.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the bus voltage is supervised while the motor is
+    stopped.
+ */
+void InitBrakeParams(void)
+{
+    brakeParm.qRegenGain = Q15(0.9999);
+    brakeParm.qRegenLimit = (int16_t)SPEEDCNTR_OUTMAX;
+    brakeParm.chopper = 0;
+    BrakeReset();
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeReset()
+
+  Summary:
+    Ends the controlled stop
+
+  Description:
+    This routine returns to the state without a stop in progress.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called when the control is reinitialized, a stop interrupted by a fault
+    or by the user ends with the PWM outputs disabled.
+ */
+void BrakeReset(void)
+{
+    brakeParm.state = BRAKE_STATE_OFF;
+    brakeParm.velRefStateVar = 0;
+    brakeParm.count = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeStart()
+
+  Summary:
+    Starts the controlled stop
+
+  Description:
+    In closed loop the speed reference is ramped down from its present value
+    to the final stage speed, otherwise the final stage starts at once.
+
+  Precondition:
+    The motor runs.
+
+  Parameters:
+    qVelRef - present speed reference
+    closedLoop - nonzero if the speed is controlled in closed loop
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void BrakeStart(int16_t qVelRef, uint16_t closedLoop)
+{
+    brakeParm.count = 0;
+    brakeParm.velRefStateVar = (int32_t)qVelRef << 16;
+    if (closedLoop != 0)
+    {
+        brakeParm.state = BRAKE_STATE_DECEL;
+    }
+    else
+    {
+        brakeParm.state = BRAKE_STATE_FINAL;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeSpeedRef()
+
+  Summary:
+    Calculates the speed reference of the stop ramp
+
+  Description:
+    The speed reference decreases from the maximum speed to zero in
+    BRAKE_DECEL_TIME_SEC and is held at the final stage speed. The final
+    stage is requested when the speed is below the final stage speed, or
+    after BRAKE_DECEL_TIME_SEC if the motor does not follow the ramp, so
+    that the stop time is bounded.
+
+  Precondition:
+    Called once every control cycle during the deceleration.
+
+  Parameters:
+    qVel - speed of the rotor
+
+  Returns:
+    Speed reference.
+
+  Remarks:
+    The regenerative current limit may slow the deceleration down when the
+    bus voltage rises.
+ */
+int16_t BrakeSpeedRef(int16_t qVel)
+{
+    int16_t qVelRef;
+
+    if (brakeParm.velRefStateVar > ((int32_t)BRAKE_FINAL_SPEED << 16))
+    {
+        brakeParm.velRefStateVar -= BRAKE_DECEL_STEP;
+        if (brakeParm.velRefStateVar < ((int32_t)BRAKE_FINAL_SPEED << 16))
+        {
+            brakeParm.velRefStateVar = (int32_t)BRAKE_FINAL_SPEED << 16;
+        }
+    }
+    else if (brakeParm.velRefStateVar < -((int32_t)BRAKE_FINAL_SPEED << 16))
+    {
+        brakeParm.velRefStateVar += BRAKE_DECEL_STEP;
+        if (brakeParm.velRefStateVar > -((int32_t)BRAKE_FINAL_SPEED << 16))
+        {
+            brakeParm.velRefStateVar = -((int32_t)BRAKE_FINAL_SPEED << 16);
+        }
+    }
+    qVelRef = (int16_t)(brakeParm.velRefStateVar >> 16);
+
+    brakeParm.count++;
+    if ((_Q15abs(qVel) <= BRAKE_FINAL_SPEED) ||
+        (brakeParm.count >= BRAKE_DECEL_COUNT))
+    {
+        brakeParm.state = BRAKE_STATE_FINAL;
+    }
+    return qVelRef;
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeRegenLimitPI()
+
+  Summary:
+    Limits the regenerative output of the speed controller
+
+  Description:
+    The output limit of the speed controller opposing the direction of
+    rotation is set to the regenerative current limit, the other limit to
+    the motoring current limit.
+
+  Precondition:
+    Called before the speed controller.
+
+  Parameters:
+    pState - pointer to the speed controller state
+    qVel - speed of the rotor
+
+  Returns:
+    None.
+
+  Remarks:
+    With the thermal protection the motoring current limit is the thermal
+    current limit.
+ */
+void BrakeRegenLimitPI(MC_PISTATE_T *pState, int16_t qVel)
+{
+#ifdef THERMAL_PROTECTION
+    int16_t limit = thermalParm.qIqLimit;
+#else
+    int16_t limit = (int16_t)SPEEDCNTR_OUTMAX;
+#endif
+    int16_t regenLimit = brakeParm.qRegenLimit;
+
+    if (regenLimit > limit)
+    {
+        regenLimit = limit;
+    }
+    if (qVel >= 0)
+    {
+        pState->outMax = limit;
+        pState->outMin = -regenLimit;
+    }
+    else
+    {
+        pState->outMax = regenLimit;
+        pState->outMin = -limit;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeRegenLimit()
+
+  Summary:
+    Limits the regenerative Iq reference
+
+  Description:
+    An Iq reference opposing the direction of rotation is limited to the
+    regenerative current limit.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qIqRef - Iq reference
+    qVel - speed of the rotor
+
+  Returns:
+    Limited Iq reference.
+
+  Remarks:
+    The speed controller output is limited already, the Iq reference is
+    limited again after the feed forward and shaping terms and in torque
+    mode.
+ */
+int16_t BrakeRegenLimit(int16_t qIqRef, int16_t qVel)
+{
+    if ((qVel >= 0) && (qIqRef < -brakeParm.qRegenLimit))
+    {
+        qIqRef = -brakeParm.qRegenLimit;
+    }
+    else if ((qVel < 0) && (qIqRef > brakeParm.qRegenLimit))
+    {
+        qIqRef = brakeParm.qRegenLimit;
+    }
+    return qIqRef;
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeAngle()
+
+  Summary:
+    Holds the angle during the DC injection
+
+  Description:
+    The angle is stored every control cycle and replaced by the last stored
+    angle while the DC current is injected.
+
+  Precondition:
+    Called once every control cycle after the angle is selected.
+
+  Parameters:
+    qAngle - angle of the rotor
+
+  Returns:
+    Angle of the d-q reference frame.
+
+  Remarks:
+    None.
+ */
+int16_t BrakeAngle(int16_t qAngle)
+{
+    if (brakeParm.state == BRAKE_STATE_DC_INJECTION)
+    {
+        return brakeParm.qAngle;
+    }
+    brakeParm.qAngle = qAngle;
+    return qAngle;
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeStepIsr()
+
+  Summary:
+    Executes the regenerative current limit, the brake chopper and the final
+    stage of the controlled stop
+
+  Description:
+    The regenerative current is reduced linearly from the speed controller
+    limit at BRAKE_REGEN_LIMIT_START to zero at BRAKE_REGEN_LIMIT_END, this
+    is the only regenerative current limit.
+    The brake chopper is switched on above BRAKE_CHOPPER_ON and off below
+    BRAKE_CHOPPER_OFF.
+    The final stage of the stop lasts BRAKE_FINAL_TIME_SEC, for the short
+    circuit the motor is stopped with the PWM outputs enabled.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    qVdc - DC bus voltage, median of the last three samples
+
+  Returns:
+    Nonzero if the motor must be stopped with the PWM outputs enabled.
+
+  Remarks:
+    While the motor is stopped with the PWM outputs enabled, all legs are
+    driven with the minimum duty cycle, the zero vector of the low side
+    switches.
+ */
+uint16_t BrakeStepIsr(int16_t qVdc)
+{
+    int32_t gain;
+    uint16_t stop = 0;
+
+    /* Regenerative current limit */
+    gain = (int32_t)BRAKE_REGEN_END - qVdc;
+    if (gain <= 0)
+    {
+        brakeParm.qRegenGain = 0;
+    }
+    else if (gain >= (BRAKE_REGEN_END - BRAKE_REGEN_START))
+    {
+        brakeParm.qRegenGain = Q15(0.9999);
+    }
+    else
+    {
+        brakeParm.qRegenGain = (int16_t)(__builtin_mulss((int16_t)gain,
+                                                BRAKE_REGEN_SLOPE) >> 8);
+    }
+    brakeParm.qRegenLimit = (int16_t)(__builtin_mulss(brakeParm.qRegenGain,
+                                        (int16_t)SPEEDCNTR_OUTMAX) >> 15);
+
+    /* Brake chopper with hysteresis */
+    if (qVdc > BRAKE_CHOPPER_ON_LEVEL)
+    {
+        brakeParm.chopper = 1;
+    }
+    else if (qVdc < BRAKE_CHOPPER_OFF_LEVEL)
+    {
+        brakeParm.chopper = 0;
+    }
+
+    /* Final stage */
+    switch (brakeParm.state)
+    {
+        case BRAKE_STATE_FINAL:
+            brakeParm.count = 0;
+            if (BRAKE_FINAL_STAGE == BRAKE_DC_INJECTION)
+            {
+                brakeParm.state = BRAKE_STATE_DC_INJECTION;
+            }
+            else
+            {
+                brakeParm.state = BRAKE_STATE_SHORT_CIRCUIT;
+                stop = 1;
+            }
+        break;
+
+        case BRAKE_STATE_SHORT_CIRCUIT:
+        case BRAKE_STATE_DC_INJECTION:
+            brakeParm.count++;
+            if (brakeParm.count >= BRAKE_FINAL_COUNT)
+            {
+                brakeParm.state = BRAKE_STATE_DONE;
+            }
+        break;
+
+        default:
+        break;
+    }
+    return stop;
+}
+// *****************************************************************************
+
+/* Function:
+    BrakeStepMain()
+
+  Summary:
+    Checks for the end of the controlled stop
+
+  Description:
+    The control is reinitialized by ResetParmeters() from the main loop, as
+    it disables the ADC interrupt.
+
+  Precondition:
+    Called from the main loop.
+
+  Parameters:
+    None
+
+  Returns:
+    Nonzero if the stop is completed.
+
+  Remarks:
+    None.
+ */
+uint16_t BrakeStepMain(void)
+{
+    return (brakeParm.state == BRAKE_STATE_DONE);
+}
+
+// </editor-fold>
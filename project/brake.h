@@ -0,0 +1,142 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file brake.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the controlled stop, the regenerative current limit and the brake
+ * chopper
+ *
+ * Component: CONTROLLED STOP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __BRAKE_H
+#define __BRAKE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Final stages of the controlled stop */
+/* All low side switches on, the motor windings are short circuited */
+#define BRAKE_SHORT_CIRCUIT     0
+/* DC current at the angle of the rotor at the start of the final stage */
+#define BRAKE_DC_INJECTION      1
+
+/* DC injection current */
+#define BRAKE_DC_CURRENT_REF    NORM_CURRENT(BRAKE_DC_CURRENT)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Brake state data type
+
+  Description:
+    Progress of the controlled stop.
+ */
+typedef enum
+{
+    /* No stop in progress */
+    BRAKE_STATE_OFF = 0,
+    /* Speed reference ramped down to the final stage speed */
+    BRAKE_STATE_DECEL = 1,
+    /* Final stage to be started */
+    BRAKE_STATE_FINAL = 2,
+    /* Motor windings short circuited by the low side switches */
+    BRAKE_STATE_SHORT_CIRCUIT = 3,
+    /* DC current injected at a fixed angle */
+    BRAKE_STATE_DC_INJECTION = 4,
+    /* Stop completed, waiting for the reinitialization */
+    BRAKE_STATE_DONE = 5
+} BRAKE_STATE_T;
+
+/* Controlled Stop Parameter data type
+
+  Description:
+    This structure will host parameters related to the controlled stop, the
+    limitation of the regenerative current by the DC bus voltage and the
+    brake chopper.
+ */
+typedef struct
+{
+    /* Progress of the controlled stop */
+    volatile BRAKE_STATE_T state;
+    /* Speed reference of the stop ramp, with 16 fractional bits */
+    int32_t velRefStateVar;
+    /* Control cycles in the present stage */
+    uint16_t count;
+    /* Angle of the DC injection */
+    int16_t qAngle;
+    /* Regenerative current weight from the DC bus voltage */
+    int16_t qRegenGain;
+    /* Regenerative current limit */
+    int16_t qRegenLimit;
+    /* Nonzero while the brake chopper is on */
+    uint16_t chopper;
+} BRAKE_PARM_T;
+
+extern BRAKE_PARM_T brakeParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitBrakeParams(void);
+void BrakeReset(void);
+void BrakeStart(int16_t qVelRef, uint16_t closedLoop);
+int16_t BrakeSpeedRef(int16_t qVel);
+void BrakeRegenLimitPI(MC_PISTATE_T *pState, int16_t qVel);
+int16_t BrakeRegenLimit(int16_t qIqRef, int16_t qVel);
+int16_t BrakeAngle(int16_t qAngle);
+uint16_t BrakeStepIsr(int16_t qVdc);
+uint16_t BrakeStepMain(void);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BRAKE_H */
@@ -115,8 +115,14 @@ typedef union
         unsigned ChangeMode:1;
         /* Speed doubled indication */
         unsigned ChangeSpeed:1;
+        /* Flying start indication - zero current control, catching rotor */
+        unsigned CatchSpin:1;
+        /* Rotor caught in reverse direction, decelerating before start up */
+        unsigned CatchReverse:1;
+        /* Initial rotor position detection in progress */
+        unsigned PositionDetect:1;
        /* Unused bits */
-        unsigned    :12;
+        unsigned    :9;
     } bits;
     uint16_t Word;
 } UGF_T;
@@ -0,0 +1,328 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file ctrlmode.c
+ *
+ * @brief This module selects at run time between speed control, torque
+ * control and torque control limited to a speed, calculates the q current
+ * reference of the torque reference and changes between the modes without a
+ * step of the q current reference.
+ *
+ * Component: CONTROL MODE
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include "ctrlmode.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* q current of one CTRL_MODE_TORQUE_UNIT_NM of torque reference, with 8
+   fractional bits */
+#define CTRL_MODE_TORQUE_GAIN   (int16_t)(256.0*CTRL_MODE_TORQUE_UNIT_NM/ \
+                                    (MOTOR_TORQUE_CONSTANT*NORM_CURRENT_CONST))
+/* q current change per control cycle of the torque slew rate, with 16
+   fractional bits */
+#define CTRL_MODE_SLEW_STEP     (int32_t)(65536.0*CTRL_MODE_TORQUE_SLEW/ \
+                                    NORM_CURRENT_CONST*LOOPTIME_SEC)
+/* Largest q current reference of the torque modes */
+#define CTRL_MODE_IQ_MAX        (int16_t)SPEEDCNTR_OUTMAX
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+CTRL_MODE_PARM_T ctrlModeParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitCtrlModeParams()
+
+  Summary:
+    Initializes control mode parameters
+
+  Description:
+    This routine requests CTRL_MODE_DEFAULT with zero torque reference.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the requested mode and torque reference are
+    kept when the control is reinitialized.
+ */
+void InitCtrlModeParams(void)
+{
+    ctrlModeParm.request = CTRL_MODE_DEFAULT;
+    ctrlModeParm.torqueRef = 0;
+    CtrlModeReset();
+}
+// *****************************************************************************
+
+/* Function:
+    CtrlModeReset()
+
+  Summary:
+    Resets the control mode in use
+
+  Description:
+    This routine starts every run in speed control, the change to the
+    requested mode is made in closed loop.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called when the control is reinitialized.
+ */
+void CtrlModeReset(void)
+{
+    ctrlModeParm.mode = CTRL_MODE_SPEED;
+    ctrlModeParm.qIqTarget = 0;
+    ctrlModeParm.iqStateVar = 0;
+    ctrlModeParm.qIqTorque = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    CtrlModeSelect()
+
+  Summary:
+    Changes the control mode without a step of the q current reference
+
+  Description:
+    When a torque mode is entered from speed control, its q current
+    reference starts at the present q current reference and slews from
+    there to the torque reference. When the speed controller takes over from
+    torque control, its integrator is loaded with the present q current
+    reference, the speed reference is tracking the speed during torque
+    control so that the speed error starts at zero.
+
+  Precondition:
+    InitCtrlModeParams() is called before.
+
+  Parameters:
+    mode    - Control mode to use
+    pState  - Speed controller state
+    qIqRef  - q current reference of the last control cycle
+
+  Returns:
+    None.
+
+  Remarks:
+    Called in closed loop every control cycle, before the speed controller.
+ */
+void CtrlModeSelect(CTRL_MODE_T mode, MC_PISTATE_T *pState, int16_t qIqRef)
+{
+    if (mode != ctrlModeParm.mode)
+    {
+        if (ctrlModeParm.mode == CTRL_MODE_SPEED)
+        {
+            ctrlModeParm.iqStateVar = (int32_t)qIqRef << 16;
+            ctrlModeParm.qIqTorque = qIqRef;
+        }
+        else if (ctrlModeParm.mode == CTRL_MODE_TORQUE)
+        {
+            pState->integrator = (int32_t)qIqRef << 13;
+        }
+        ctrlModeParm.mode = mode;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    CtrlModeTorque()
+
+  Summary:
+    q current reference of the torque reference
+
+  Description:
+    This routine converts the torque reference to the q current with the
+    torque constant 1.5*p*psi, MOTOR_TORQUE_CONSTANT, limits it to the speed
+    controller output limit and moves the q current reference towards it by
+    at most CTRL_MODE_TORQUE_SLEW.
+
+  Precondition:
+    CtrlModeSelect() is called before in the same control cycle.
+
+  Parameters:
+    None
+
+  Returns:
+    q current reference of the torque modes.
+
+  Remarks:
+    Called every control cycle in the torque modes. The reluctance torque of
+    MTPA is not included in the torque constant.
+ */
+int16_t CtrlModeTorque(void)
+{
+    int32_t temp;
+
+    temp = __builtin_mulss(ctrlModeParm.torqueRef, CTRL_MODE_TORQUE_GAIN) >> 8;
+    if (temp > CTRL_MODE_IQ_MAX)
+    {
+        temp = CTRL_MODE_IQ_MAX;
+    }
+    else if (temp < -CTRL_MODE_IQ_MAX)
+    {
+        temp = -CTRL_MODE_IQ_MAX;
+    }
+    ctrlModeParm.qIqTarget = (int16_t)temp;
+
+    temp = ((int32_t)ctrlModeParm.qIqTarget << 16) - ctrlModeParm.iqStateVar;
+    if (temp > CTRL_MODE_SLEW_STEP)
+    {
+        ctrlModeParm.iqStateVar += CTRL_MODE_SLEW_STEP;
+    }
+    else if (temp < -CTRL_MODE_SLEW_STEP)
+    {
+        ctrlModeParm.iqStateVar -= CTRL_MODE_SLEW_STEP;
+    }
+    else
+    {
+        ctrlModeParm.iqStateVar = (int32_t)ctrlModeParm.qIqTarget << 16;
+    }
+    ctrlModeParm.qIqTorque = (int16_t)(ctrlModeParm.iqStateVar >> 16);
+
+    return ctrlModeParm.qIqTorque;
+}
+// *****************************************************************************
+
+/* Function:
+    CtrlModeSpeedLimit()
+
+  Summary:
+    Speed limit of the speed limited torque mode
+
+  Description:
+    This routine returns the magnitude of the speed reference in the
+    direction of the torque reference, the speed the motor accelerates to
+    when the load does not hold the torque.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qVelRef - Speed reference
+
+  Returns:
+    Reference of the speed controller.
+
+  Remarks:
+    None.
+ */
+int16_t CtrlModeSpeedLimit(int16_t qVelRef)
+{
+    if (qVelRef < 0)
+    {
+        qVelRef = -qVelRef;
+    }
+    if (ctrlModeParm.qIqTarget < 0)
+    {
+        qVelRef = -qVelRef;
+    }
+    return qVelRef;
+}
+// *****************************************************************************
+
+/* Function:
+    CtrlModeLimitPI()
+
+  Summary:
+    Limits the speed controller output to the torque reference
+
+  Description:
+    This routine limits the speed controller output in the direction of the
+    torque to the q current reference of the torque reference. Below the
+    speed limit the speed controller saturates at the torque, at the speed
+    limit it reduces the torque to hold the speed. The limit in the other
+    direction is kept, so that the speed controller can brake an overhauling
+    load.
+
+  Precondition:
+    CtrlModeTorque() is called before in the same control cycle.
+
+  Parameters:
+    pState - Speed controller state
+
+  Returns:
+    None.
+
+  Remarks:
+    Called after the other limits of the speed controller output.
+ */
+void CtrlModeLimitPI(MC_PISTATE_T *pState)
+{
+    if (ctrlModeParm.qIqTorque >= 0)
+    {
+        if (pState->outMax > ctrlModeParm.qIqTorque)
+        {
+            pState->outMax = ctrlModeParm.qIqTorque;
+        }
+    }
+    else
+    {
+        if (pState->outMin < ctrlModeParm.qIqTorque)
+        {
+            pState->outMin = ctrlModeParm.qIqTorque;
+        }
+    }
+}
+
+// </editor-fold>
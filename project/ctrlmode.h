@@ -0,0 +1,117 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file ctrlmode.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the run time selection of speed, torque and speed limited torque control
+ *
+ * Component: CONTROL MODE
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __CTRLMODE_H
+#define __CTRLMODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Control mode data type
+
+  Description:
+    Reference of the current controllers in closed loop.
+ */
+typedef enum
+{
+    /* Iq reference from the speed controller */
+    CTRL_MODE_SPEED = 0,
+    /* Iq reference from the torque reference */
+    CTRL_MODE_TORQUE = 1,
+    /* Iq reference from the torque reference, reduced by the speed
+       controller at the speed reference */
+    CTRL_MODE_SPEED_LIMITED_TORQUE = 2
+} CTRL_MODE_T;
+
+/* Control Mode Parameter data type
+
+  Description:
+    This structure will host parameters related to the control mode, the
+    torque reference and the change between the modes.
+ */
+typedef struct
+{
+    /* Requested control mode */
+    volatile CTRL_MODE_T request;
+    /* Control mode in use */
+    CTRL_MODE_T mode;
+    /* Torque reference in CTRL_MODE_TORQUE_UNIT_NM units */
+    volatile int16_t torqueRef;
+    /* Iq reference of the torque reference */
+    int16_t qIqTarget;
+    /* Iq reference of the torque modes, following qIqTarget at
+       CTRL_MODE_TORQUE_SLEW, with 16 fractional bits */
+    int32_t iqStateVar;
+    int16_t qIqTorque;
+} CTRL_MODE_PARM_T;
+
+extern CTRL_MODE_PARM_T ctrlModeParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitCtrlModeParams(void);
+void CtrlModeReset(void);
+void CtrlModeSelect(CTRL_MODE_T mode, MC_PISTATE_T *pState, int16_t qIqRef);
+int16_t CtrlModeTorque(void);
+int16_t CtrlModeSpeedLimit(int16_t qVelRef);
+void CtrlModeLimitPI(MC_PISTATE_T *pState);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CTRLMODE_H */
@@ -0,0 +1,450 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file currentpredict.c
+ *
+ * @brief This module predicts the phase currents from the motor model and
+ * blends the prediction with the single shunt reconstruction according to
+ * the validity of the bus current samples.
+ *
+ * Component: CURRENT PREDICTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "currentpredict.h"
+#include "general.h"
+#include "userparms.h"
+#include "estim.h"
+#include "pwm.h"
+#ifdef DC_BUS_COMPENSATION
+#include "dcbuscomp.h"
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Gains from the duty cycle differences, summed over both halves of the PWM
+   period, to the alpha and beta voltages, Q12. The modulator input is 
+   rescaled by NORM_VOLTAGE_BASE_RATIO to the voltage base of valphabeta */
+#define CURRENTPREDICT_ALPHA_GAIN   (int16_t)(4096.0*32768.0* \
+                    NORM_VOLTAGE_BASE_RATIO/(3.4641016*LOOPTIME_TCY))
+#define CURRENTPREDICT_BETA_GAIN    (int16_t)(4096.0*32768.0* \
+                    NORM_VOLTAGE_BASE_RATIO/(2.0*LOOPTIME_TCY))
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+CURRENT_PREDICT_PARM_T currentPredictParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static int16_t CurrentPredictDelta(int16_t qV, int16_t qI, int16_t qBemf);
+static int16_t CurrentPredictMix(int16_t qPredicted, int16_t qMeasured,
+                                 int16_t qConfidence);
+static int16_t CurrentPredictSaturate(int32_t value);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitCurrentPredictParams()
+
+  Summary:
+    Initializes current prediction parameters
+
+  Description:
+    This routine initializes the current prediction structure variables
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitCurrentPredictParams(void)
+{
+    currentPredictParm.valphabeta.alpha = 0;
+    currentPredictParm.valphabeta.beta = 0;
+    currentPredictParm.ialphabetaLast.alpha = 0;
+    currentPredictParm.ialphabetaLast.beta = 0;
+    currentPredictParm.ialphabeta.alpha = 0;
+    currentPredictParm.ialphabeta.beta = 0;
+    currentPredictParm.iabc.a = 0;
+    currentPredictParm.iabc.b = 0;
+    currentPredictParm.iabc.c = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    CurrentPredict()
+
+  Summary:
+    Predicts the phase currents of the present sample
+
+  Description:
+    The stator voltage equation V = Rs * I + Ls * dI/dt + BEMF is solved for
+    the current change over one control cycle, starting from the currents
+    reconstructed in the previous cycle, with the voltage applied in the
+    previous cycle and the BEMF from the estimator. The prediction is
+    transformed to phase currents.
+
+  Precondition:
+    Called before the phase current reconstruction, while the estimator BEMF
+    still holds the value of the previous control cycle.
+
+  Parameters:
+    pValphabeta - pointer to the voltage applied in the previous cycle,
+                  currentPredictParm.valphabeta
+    pBemfAlphabeta - pointer to the BEMF of the previous cycle
+
+  Returns:
+    None.
+
+  Remarks:
+    The prediction uses the normalized estimator parameters, motorParm.qRs
+    and motorParm.qLsDt.
+ */
+void CurrentPredict(const MC_ALPHABETA_T *pValphabeta,
+                    const MC_ALPHABETA_T *pBemfAlphabeta)
+{
+    int32_t current;
+
+    current = (int32_t)currentPredictParm.ialphabetaLast.alpha +
+            CurrentPredictDelta(pValphabeta->alpha,
+                currentPredictParm.ialphabetaLast.alpha, pBemfAlphabeta->alpha);
+    if (current > Q15(0.9999))
+    {
+        current = Q15(0.9999);
+    }
+    else if (current < Q15(-0.9999))
+    {
+        current = Q15(-0.9999);
+    }
+    currentPredictParm.ialphabeta.alpha = (int16_t)current;
+
+    current = (int32_t)currentPredictParm.ialphabetaLast.beta +
+            CurrentPredictDelta(pValphabeta->beta,
+                currentPredictParm.ialphabetaLast.beta, pBemfAlphabeta->beta);
+    if (current > Q15(0.9999))
+    {
+        current = Q15(0.9999);
+    }
+    else if (current < Q15(-0.9999))
+    {
+        current = Q15(-0.9999);
+    }
+    currentPredictParm.ialphabeta.beta = (int16_t)current;
+
+    MC_TransformClarkeInverse_Assembly(&currentPredictParm.ialphabeta,
+                                       &currentPredictParm.iabc);
+}
+// *****************************************************************************
+
+/* Function:
+    CurrentPredictBlend()
+
+  Summary:
+    Blends the predicted and reconstructed phase currents
+
+  Description:
+    The first bus current sample gives the current of one phase and the
+    second sample the current of another phase, depending on the sector of
+    the PWM pattern. Each of these phase currents is blended with its
+    prediction according to the confidence of the sample, the third phase
+    current follows from the sum of the phase currents being zero.
+    The result is stored for the prediction of the next cycle.
+
+  Precondition:
+    SingleShunt_PhaseCurrentReconstruction() must be called before.
+
+  Parameters:
+    pSingleShunt - pointer to the single shunt parameters
+
+  Returns:
+    None.
+
+  Remarks:
+    When the pattern sector is not known, the prediction is used.
+ */
+void CurrentPredictBlend(SINGLE_SHUNT_PARM_T *pSingleShunt)
+{
+    int16_t qConfidence1 = pSingleShunt->confidence1;
+    int16_t qConfidence2 = pSingleShunt->confidence2;
+    MC_ABC_T iabc;
+    
+    switch(pSingleShunt->sectorSVM)
+    {
+        case 1:
+            pSingleShunt->Ib = CurrentPredictMix(currentPredictParm.iabc.b,
+                                            pSingleShunt->Ib, qConfidence1);
+            pSingleShunt->Ic = CurrentPredictMix(currentPredictParm.iabc.c,
+                                            pSingleShunt->Ic, qConfidence2);
+            pSingleShunt->Ia = -pSingleShunt->Ic - pSingleShunt->Ib;
+        break;
+        case 2:
+            pSingleShunt->Ia = CurrentPredictMix(currentPredictParm.iabc.a,
+                                            pSingleShunt->Ia, qConfidence1);
+            pSingleShunt->Ib = CurrentPredictMix(currentPredictParm.iabc.b,
+                                            pSingleShunt->Ib, qConfidence2);
+            pSingleShunt->Ic = -pSingleShunt->Ia - pSingleShunt->Ib;
+        break;
+        case 3:
+            pSingleShunt->Ia = CurrentPredictMix(currentPredictParm.iabc.a,
+                                            pSingleShunt->Ia, qConfidence1);
+            pSingleShunt->Ic = CurrentPredictMix(currentPredictParm.iabc.c,
+                                            pSingleShunt->Ic, qConfidence2);
+            pSingleShunt->Ib = -pSingleShunt->Ia - pSingleShunt->Ic;
+        break;
+        case 4:
+            pSingleShunt->Ic = CurrentPredictMix(currentPredictParm.iabc.c,
+                                            pSingleShunt->Ic, qConfidence1);
+            pSingleShunt->Ia = CurrentPredictMix(currentPredictParm.iabc.a,
+                                            pSingleShunt->Ia, qConfidence2);
+            pSingleShunt->Ib = -pSingleShunt->Ia - pSingleShunt->Ic;
+        break;
+        case 5:
+            pSingleShunt->Ib = CurrentPredictMix(currentPredictParm.iabc.b,
+                                            pSingleShunt->Ib, qConfidence1);
+            pSingleShunt->Ia = CurrentPredictMix(currentPredictParm.iabc.a,
+                                            pSingleShunt->Ia, qConfidence2);
+            pSingleShunt->Ic = -pSingleShunt->Ia - pSingleShunt->Ib;
+        break;
+        case 6:
+            pSingleShunt->Ic = CurrentPredictMix(currentPredictParm.iabc.c,
+                                            pSingleShunt->Ic, qConfidence1);
+            pSingleShunt->Ib = CurrentPredictMix(currentPredictParm.iabc.b,
+                                            pSingleShunt->Ib, qConfidence2);
+            pSingleShunt->Ia = -pSingleShunt->Ic - pSingleShunt->Ib;
+        break;
+        default:
+            pSingleShunt->Ia = currentPredictParm.iabc.a;
+            pSingleShunt->Ib = currentPredictParm.iabc.b;
+            pSingleShunt->Ic = currentPredictParm.iabc.c;
+        break;
+    }
+
+    iabc.a = pSingleShunt->Ia;
+    iabc.b = pSingleShunt->Ib;
+    iabc.c = pSingleShunt->Ic;
+    MC_TransformClarke_Assembly(&iabc, &currentPredictParm.ialphabetaLast);
+}
+// *****************************************************************************
+
+/* Function:
+    CurrentPredictVoltage()
+
+  Summary:
+    Calculates the voltage applied by the duty cycles
+
+  Description:
+    The alpha-beta voltages are calculated back from the duty cycles written
+    to the PWM generator, after the DC bus compensation, the overmodulation,
+    the measurement window shift and the duty cycle limits. The duty cycle
+    differences of the legs are the phase voltages of the swapped inverse
+    Clarke transform, beta = d2 - d3 and alpha = (2*d1 - d2 - d3)/sqrt(3).
+    With DC bus compensation the voltages are scaled with the measured bus
+    voltage, as the modulator input was scaled with its reciprocal.
+
+  Precondition:
+    Called after PWMDutyCycleSetDualEdge() has limited the duty cycles.
+
+  Parameters:
+    pSingleShunt - pointer to the single shunt parameters
+
+  Returns:
+    None.
+
+  Remarks:
+    The voltage error of the dead time is not included.
+ */
+void CurrentPredictVoltage(const SINGLE_SHUNT_PARM_T *pSingleShunt)
+{
+    int32_t duty1, duty2, duty3, voltage;
+
+    duty1 = (int32_t)pSingleShunt->pwmDutycycle1.dutycycle1 +
+            pSingleShunt->pwmDutycycle2.dutycycle1;
+    duty2 = (int32_t)pSingleShunt->pwmDutycycle1.dutycycle2 +
+            pSingleShunt->pwmDutycycle2.dutycycle2;
+    duty3 = (int32_t)pSingleShunt->pwmDutycycle1.dutycycle3 +
+            pSingleShunt->pwmDutycycle2.dutycycle3;
+
+    voltage = (((duty1 << 1) - duty2 - duty3) * CURRENTPREDICT_ALPHA_GAIN) >> 12;
+#ifdef DC_BUS_COMPENSATION
+    voltage = (CurrentPredictSaturate(voltage) * 
+               (int32_t)dcBusCompParm.qVdc) >> 12;
+#endif
+    currentPredictParm.valphabeta.alpha = CurrentPredictSaturate(voltage);
+
+    voltage = ((duty2 - duty3) * CURRENTPREDICT_BETA_GAIN) >> 12;
+#ifdef DC_BUS_COMPENSATION
+    voltage = (CurrentPredictSaturate(voltage) * 
+               (int32_t)dcBusCompParm.qVdc) >> 12;
+#endif
+    currentPredictParm.valphabeta.beta = CurrentPredictSaturate(voltage);
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    CurrentPredictDelta()
+
+  Summary:
+    Current change over one control cycle from the voltage equation
+
+  Description:
+    dI = (V - Rs * I - BEMF) / (Ls/dt), with the scaling of the estimator.
+    The inductive voltage is limited so that the division does not overflow.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qV - applied voltage
+    qI - current
+    qBemf - BEMF voltage
+
+  Returns:
+    Current change.
+
+  Remarks:
+    None.
+ */
+static int16_t CurrentPredictDelta(int16_t qV, int16_t qI, int16_t qBemf)
+{
+    int32_t vInd, vIndMax;
+
+    vInd = (int32_t)qV - qBemf -
+            (int16_t)(__builtin_mulss(motorParm.qRs, qI) >> NORM_RS_SCALE_SHIFT);
+    vIndMax = __builtin_mulss(Q15(0.9999), motorParm.qLsDt) >> 
+                                                NORM_LSDTBASE_SCALE_SHIFT;
+    if (vInd > vIndMax)
+    {
+        vInd = vIndMax;
+    }
+    else if (vInd < -vIndMax)
+    {
+        vInd = -vIndMax;
+    }
+    return __builtin_divsd(vInd << NORM_LSDTBASE_SCALE_SHIFT, motorParm.qLsDt);
+}
+// *****************************************************************************
+
+/* Function:
+    CurrentPredictMix()
+
+  Summary:
+    Blends a predicted and a measured current
+
+  Description:
+    Returns qPredicted + qConfidence * (qMeasured - qPredicted).
+
+  Precondition:
+    None.
+
+  Parameters:
+    qPredicted - predicted current
+    qMeasured - measured current
+    qConfidence - confidence of the measurement, 0 to Q15(0.9999)
+
+  Returns:
+    Blended current.
+
+  Remarks:
+    None.
+ */
+static int16_t CurrentPredictMix(int16_t qPredicted, int16_t qMeasured,
+                                 int16_t qConfidence)
+{
+    int16_t qDelta = (int16_t)(((int32_t)qMeasured - qPredicted) >> 1);
+
+    return qPredicted + 
+            (int16_t)(__builtin_mulss(qConfidence, qDelta) >> 14);
+}
+// *****************************************************************************
+
+/* Function:
+    CurrentPredictSaturate()
+
+  Summary:
+    Limits a voltage to the Q15 range
+
+  Description:
+    Returns the value limited to -Q15(0.9999) to Q15(0.9999).
+
+  Precondition:
+    None.
+
+  Parameters:
+    value - voltage in Q15 with 32 bits
+
+  Returns:
+    Limited voltage.
+
+  Remarks:
+    None.
+ */
+static int16_t CurrentPredictSaturate(int32_t value)
+{
+    if (value > Q15(0.9999))
+    {
+        value = Q15(0.9999);
+    }
+    else if (value < -Q15(0.9999))
+    {
+        value = -Q15(0.9999);
+    }
+    return (int16_t)value;
+}
+
+// </editor-fold>
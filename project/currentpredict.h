@@ -0,0 +1,99 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file currentpredict.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the model based phase current prediction for single shunt
+ * reconstruction
+ *
+ * Component: CURRENT PREDICTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __CURRENTPREDICT_H
+#define __CURRENTPREDICT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+#include "singleshunt.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Current Prediction Parameter data type
+
+  Description:
+    This structure will host parameters related to the model based phase
+    current prediction.
+ */
+typedef struct
+{
+    /* Alpha-beta voltages applied by the duty cycles of the previous control
+       cycle, in the voltage base of valphabeta */
+    MC_ALPHABETA_T valphabeta;
+    /* Reconstructed alpha-beta currents of the previous control cycle */
+    MC_ALPHABETA_T ialphabetaLast;
+    /* Predicted alpha-beta currents */
+    MC_ALPHABETA_T ialphabeta;
+    /* Predicted phase currents */
+    MC_ABC_T iabc;
+} CURRENT_PREDICT_PARM_T;
+
+extern CURRENT_PREDICT_PARM_T currentPredictParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitCurrentPredictParams(void);
+void CurrentPredict(const MC_ALPHABETA_T *pValphabeta,
+                    const MC_ALPHABETA_T *pBemfAlphabeta);
+void CurrentPredictBlend(SINGLE_SHUNT_PARM_T *pSingleShunt);
+void CurrentPredictVoltage(const SINGLE_SHUNT_PARM_T *pSingleShunt);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CURRENTPREDICT_H */
@@ -0,0 +1,399 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file dcbuscomp.c
+ *
+ * @brief This module scales the modulator input with the reciprocal of the
+ * DC bus voltage, so that the applied voltage is independent of the bus
+ * voltage level and of its rectifier ripple. For reduced DC link capacitance
+ * the Iq reference can be shaped to draw a sinusoidal mains current.
+ *
+ * Component: DC BUS VOLTAGE COMPENSATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "dcbuscomp.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Binary point of the normalized bus voltages and of the gains */
+#define DCBUS_COMP_Q            12
+/* Unity in DCBUS_COMP_Q */
+#define DCBUS_COMP_ONE          4096
+/* Nominal bus voltage in counts of the ADC buffer */
+#define DCBUS_NOMINAL_COUNTS    (DC_BUS_VOLTAGE_NOMINAL*65535.0/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+/* Gain converting the ADC buffer into the normalized bus voltage */
+#define DCBUS_NORM_GAIN         (int16_t)(DCBUS_COMP_ONE*65536.0/ \
+                                    DCBUS_NOMINAL_COUNTS)
+/* Limits of the reciprocal of the normalized bus voltage */
+#define DCBUS_COMP_GAIN_MIN     (int16_t)(DCBUS_COMP_ONE*DC_BUS_COMP_GAIN_MIN)
+#define DCBUS_COMP_GAIN_MAX     (int16_t)(DCBUS_COMP_ONE*DC_BUS_COMP_GAIN_MAX)
+#ifdef DC_LINK_RIPPLE_SHAPING
+/* Limits of the reciprocal of the normalized square of the bus voltage */
+#define DCBUS_SQ_GAIN_MIN       (int16_t)(DCBUS_COMP_ONE*0.25)
+#define DCBUS_SQ_GAIN_MAX       (int16_t)(DCBUS_COMP_ONE*3.9998)
+#endif
+/* Filter constant of the bus voltage, 2*pi*fc*Ts */
+#define DCBUS_KFILTER           Q15(6.2832*DC_BUS_FILTER_CUTOFF_HZ* \
+                                    LOOPTIME_SEC)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+DCBUS_COMP_PARM_T dcBusCompParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static int16_t DCBusCompReciprocal(int16_t qVdc, int16_t qInvVdc,
+                                   int16_t qMin, int16_t qMax);
+static int16_t DCBusCompScale(int16_t qVoltage, int16_t qGain);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitDCBusCompParams()
+
+  Summary:
+    Initializes DC bus voltage compensation parameters
+
+  Description:
+    This routine initializes the DC bus voltage compensation structure
+    variables to the nominal bus voltage and unity gain
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    The filter keeps running while the motor is stopped, the routine is
+    called once at power up and not with the other motor parameters.
+ */
+void InitDCBusCompParams(void)
+{
+    dcBusCompParm.qKfilter = DCBUS_KFILTER;
+    dcBusCompParm.qVdc = DCBUS_COMP_ONE;
+    dcBusCompParm.qVdcFilt = DCBUS_COMP_ONE;
+    dcBusCompParm.qVdcStateVar = (int32_t)DCBUS_COMP_ONE << 15;
+    dcBusCompParm.qInvVdcFilt = DCBUS_COMP_ONE;
+    dcBusCompParm.qGain = DCBUS_COMP_ONE;
+    dcBusCompParm.valphabeta.alpha = 0;
+    dcBusCompParm.valphabeta.beta = 0;
+#ifdef DC_LINK_RIPPLE_SHAPING
+    dcBusCompParm.qVdcSq = DCBUS_COMP_ONE;
+    dcBusCompParm.qVdcSqFilt = DCBUS_COMP_ONE;
+    dcBusCompParm.qVdcSqStateVar = (int32_t)DCBUS_COMP_ONE << 15;
+    dcBusCompParm.qInvVdcSqFilt = DCBUS_COMP_ONE;
+    dcBusCompParm.qShape = DCBUS_COMP_ONE;
+#endif
+}
+// *****************************************************************************
+
+/* Function:
+    DCBusCompUpdate()
+
+  Summary:
+    Updates the reciprocal of the DC bus voltage
+
+  Description:
+    The measured bus voltage is normalized to DC_BUS_VOLTAGE_NOMINAL and
+    low pass filtered below the rectifier ripple frequency. The reciprocal of
+    the filtered voltage is tracked by one Newton iteration per call,
+    r = r * (2 - Vdc * r), which replaces the division; as the filtered
+    voltage changes slowly a single iteration keeps the reciprocal converged.
+    The ripple is fed forward by one more iteration from the filtered
+    reciprocal with the unfiltered voltage, which is the first order
+    expansion of the reciprocal around the filtered voltage. With a ripple of
+    10% of the bus voltage its error is 1%.
+
+  Precondition:
+    None.
+
+  Parameters:
+    adcVbus - ADC buffer of the bus voltage, unsigned fractional
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once every control cycle before the control, also while the
+    motor is stopped, so that the voltage sampled with the phase currents
+    is used in the same cycle.
+ */
+void DCBusCompUpdate(uint16_t adcVbus)
+{
+    int16_t tempint;
+
+    dcBusCompParm.qVdc = (int16_t)(__builtin_mulsu(DCBUS_NORM_GAIN,
+                                                   adcVbus) >> 16);
+
+    tempint = dcBusCompParm.qVdc - dcBusCompParm.qVdcFilt;
+    dcBusCompParm.qVdcStateVar += __builtin_mulss(tempint,
+                                                  dcBusCompParm.qKfilter);
+    dcBusCompParm.qVdcFilt = (int16_t)(dcBusCompParm.qVdcStateVar >> 15);
+
+    dcBusCompParm.qInvVdcFilt = DCBusCompReciprocal(dcBusCompParm.qVdcFilt,
+                    dcBusCompParm.qInvVdcFilt, DCBUS_COMP_GAIN_MIN,
+                    DCBUS_COMP_GAIN_MAX);
+    dcBusCompParm.qGain = DCBusCompReciprocal(dcBusCompParm.qVdc,
+                    dcBusCompParm.qInvVdcFilt, DCBUS_COMP_GAIN_MIN,
+                    DCBUS_COMP_GAIN_MAX);
+
+#ifdef DC_LINK_RIPPLE_SHAPING
+    /* Mean of the square of the bus voltage and its reciprocal */
+    dcBusCompParm.qVdcSq = (int16_t)(__builtin_mulss(dcBusCompParm.qVdc,
+                                    dcBusCompParm.qVdc) >> DCBUS_COMP_Q);
+    tempint = dcBusCompParm.qVdcSq - dcBusCompParm.qVdcSqFilt;
+    dcBusCompParm.qVdcSqStateVar += __builtin_mulss(tempint,
+                                                    dcBusCompParm.qKfilter);
+    dcBusCompParm.qVdcSqFilt = (int16_t)(dcBusCompParm.qVdcSqStateVar >> 15);
+    dcBusCompParm.qInvVdcSqFilt = DCBusCompReciprocal(
+                    dcBusCompParm.qVdcSqFilt, dcBusCompParm.qInvVdcSqFilt,
+                    DCBUS_SQ_GAIN_MIN, DCBUS_SQ_GAIN_MAX);
+    dcBusCompParm.qShape = (int16_t)(__builtin_mulss(dcBusCompParm.qVdcSq,
+                            dcBusCompParm.qInvVdcSqFilt) >> DCBUS_COMP_Q);
+#endif
+}
+// *****************************************************************************
+
+/* Function:
+    DCBusCompensate()
+
+  Summary:
+    Scales the alpha-beta voltages with the reciprocal of the bus voltage
+
+  Description:
+    The voltage references are in the voltage base of the nominal bus
+    voltage, the modulator input is the reference multiplied by the ratio
+    of the nominal to the actual bus voltage.
+
+  Precondition:
+    DCBusCompUpdate() must be called every control cycle.
+
+  Parameters:
+    pVAlphaBeta - pointer to the alpha-beta voltage references
+    pVAlphaBetaComp - pointer to the compensated alpha-beta voltages
+
+  Returns:
+    None.
+
+  Remarks:
+    The references are not modified, they remain the voltages applied to the
+    motor for the estimator. The compensated voltages are limited to the Q15
+    range.
+ */
+void DCBusCompensate(const MC_ALPHABETA_T *pVAlphaBeta,
+                     MC_ALPHABETA_T *pVAlphaBetaComp)
+{
+    pVAlphaBetaComp->alpha = DCBusCompScale(pVAlphaBeta->alpha,
+                                            dcBusCompParm.qGain);
+    pVAlphaBetaComp->beta = DCBusCompScale(pVAlphaBeta->beta,
+                                           dcBusCompParm.qGain);
+}
+
+#ifdef DC_LINK_RIPPLE_SHAPING
+// *****************************************************************************
+
+/* Function:
+    DCBusRippleShape()
+
+  Summary:
+    Shapes the Iq reference with the bus voltage ripple
+
+  Description:
+    With a small DC link capacitor the bus voltage follows the rectified
+    mains voltage and the mains current is the motor power divided by the
+    bus voltage. The Iq reference, and at a given speed the motor power, is
+    weighted with the ratio of the square of the bus voltage to its mean, so
+    that the mains current is proportional to the mains voltage while the
+    mean Iq is the speed controller output. When the current regenerates
+    energy into the DC link it is not shaped, the regenerative current is
+    limited by BrakeRegenLimit() afterwards.
+
+  Precondition:
+    DCBusCompUpdate() must be called in the same control cycle.
+
+  Parameters:
+    qIqRef - Iq reference
+    qVel - estimated speed
+
+  Returns:
+    Shaped Iq reference limited to SPEEDCNTR_OUTMAX.
+
+  Remarks:
+    The torque pulsates at twice the mains frequency, the speed controller
+    bandwidth must be well below it so that it does not counteract the
+    shaping.
+ */
+int16_t DCBusRippleShape(int16_t qIqRef, int16_t qVel)
+{
+    int32_t iq;
+
+    if (((qIqRef > 0) && (qVel < 0)) || ((qIqRef < 0) && (qVel > 0)))
+    {
+        return qIqRef;
+    }
+    iq = __builtin_mulss(qIqRef, dcBusCompParm.qShape) >> DCBUS_COMP_Q;
+
+    if (iq > SPEEDCNTR_OUTMAX)
+    {
+        iq = SPEEDCNTR_OUTMAX;
+    }
+    else if (iq < -SPEEDCNTR_OUTMAX)
+    {
+        iq = -SPEEDCNTR_OUTMAX;
+    }
+    return (int16_t)iq;
+}
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    DCBusCompReciprocal()
+
+  Summary:
+    One Newton iteration of the reciprocal of the bus voltage
+
+  Description:
+    Returns qInvVdc * (2 - qVdc * qInvVdc) limited to qMin and qMax. The
+    product qVdc * qInvVdc is limited below 2 so that the iteration recovers
+    from an estimate too large for a sudden rise of the bus voltage.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qVdc - normalized bus voltage
+    qInvVdc - estimate of the reciprocal
+    qMin - minimum of the reciprocal
+    qMax - maximum of the reciprocal
+
+  Returns:
+    Improved estimate of the reciprocal.
+
+  Remarks:
+    None.
+ */
+static int16_t DCBusCompReciprocal(int16_t qVdc, int16_t qInvVdc,
+                                   int16_t qMin, int16_t qMax)
+{
+    int32_t product;
+
+    product = __builtin_mulss(qVdc, qInvVdc) >> DCBUS_COMP_Q;
+    if (product < 0)
+    {
+        product = 0;
+    }
+    else if (product > ((DCBUS_COMP_ONE << 1) - 1))
+    {
+        product = (DCBUS_COMP_ONE << 1) - 1;
+    }
+
+    product = __builtin_mulss(qInvVdc,
+                (int16_t)((DCBUS_COMP_ONE << 1) - product)) >> DCBUS_COMP_Q;
+    if (product < qMin)
+    {
+        product = qMin;
+    }
+    else if (product > qMax)
+    {
+        product = qMax;
+    }
+    return (int16_t)product;
+}
+// *****************************************************************************
+
+/* Function:
+    DCBusCompScale()
+
+  Summary:
+    Multiplies a voltage with the compensation gain
+
+  Description:
+    Returns qVoltage * qGain limited to the Q15 range.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qVoltage - voltage
+    qGain - gain in DCBUS_COMP_Q
+
+  Returns:
+    Scaled voltage.
+
+  Remarks:
+    None.
+ */
+static int16_t DCBusCompScale(int16_t qVoltage, int16_t qGain)
+{
+    int32_t voltage = __builtin_mulss(qVoltage, qGain) >> DCBUS_COMP_Q;
+
+    if (voltage > Q15(0.9999))
+    {
+        voltage = Q15(0.9999);
+    }
+    else if (voltage < Q15(-0.9999))
+    {
+        voltage = Q15(-0.9999);
+    }
+    return (int16_t)voltage;
+}
+
+// </editor-fold>
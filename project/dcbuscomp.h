@@ -0,0 +1,121 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file dcbuscomp.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the DC bus voltage compensation
+ *
+ * Component: DC BUS VOLTAGE COMPENSATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __DCBUSCOMP_H
+#define __DCBUSCOMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* DC Bus Voltage Compensation Parameter data type
+
+  Description:
+    This structure will host parameters related to the compensation of the
+    modulator input for the deviation of the DC bus voltage from its nominal
+    value. Bus voltages and gains are in Q12, 4096 is the nominal bus voltage
+    and unity gain.
+ */
+typedef struct
+{
+    /* Bus voltage normalized to the nominal bus voltage */
+    int16_t qVdc;
+    /* Filtered bus voltage */
+    int16_t qVdcFilt;
+    /* State variable for the filtered bus voltage */
+    int32_t qVdcStateVar;
+    /* Filter constant of the bus voltage */
+    int16_t qKfilter;
+    /* Reciprocal of the filtered bus voltage */
+    int16_t qInvVdcFilt;
+    /* Reciprocal of the bus voltage with the ripple feed forward, applied to
+       the modulator input */
+    int16_t qGain;
+    /* Compensated alpha-beta voltages */
+    MC_ALPHABETA_T valphabeta;
+#ifdef DC_LINK_RIPPLE_SHAPING
+    /* Square of the bus voltage */
+    int16_t qVdcSq;
+    /* Filtered square of the bus voltage */
+    int16_t qVdcSqFilt;
+    /* State variable for the filtered square of the bus voltage */
+    int32_t qVdcSqStateVar;
+    /* Reciprocal of the filtered square of the bus voltage */
+    int16_t qInvVdcSqFilt;
+    /* Ratio of the square of the bus voltage to its mean, Iq reference 
+       weight */
+    int16_t qShape;
+#endif
+} DCBUS_COMP_PARM_T;
+
+extern DCBUS_COMP_PARM_T dcBusCompParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitDCBusCompParams(void);
+void DCBusCompUpdate(uint16_t adcVbus);
+void DCBusCompensate(const MC_ALPHABETA_T *pVAlphaBeta,
+                     MC_ALPHABETA_T *pVAlphaBetaComp);
+#ifdef DC_LINK_RIPPLE_SHAPING
+int16_t DCBusRippleShape(int16_t qIqRef, int16_t qVel);
+#endif
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DCBUSCOMP_H */
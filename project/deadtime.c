@@ -0,0 +1,223 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file deadtime.c
+ *
+ * @brief This module compensates the voltage error of the inverter caused by
+ * the dead time and the voltage drop of the power devices.
+ *
+ * Component: DEAD TIME COMPENSATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "deadtime.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Average voltage error of one leg caused by the dead time, the normalized 
+   voltage is 1 for Vdc/sqrt(3) so the error DEADTIME/LOOPTIME*Vdc is 
+   sqrt(3)*DEADTIME/LOOPTIME */
+#define DEADTIME_VOLTAGE    (1.732*DEADTIME_MICROSEC/LOOPTIME_MICROSEC)
+/* Sum of dead time and device voltage drop */
+#define DEADTIME_COMP_VOLTAGE   NORM_VOLTAGE_SCALE(Q15(DEADTIME_VOLTAGE) + \
+                                                DEADTIME_COMP_DEVICE_DROP)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+DEADTIME_PARM_T deadTimeParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static int16_t DeadTimeSmoothSign(int16_t qCurrent);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitDeadTimeParams()
+
+  Summary:
+    Initializes dead time compensation parameters
+
+  Description:
+    This routine initializes the dead time compensation structure variables
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitDeadTimeParams(void)
+{
+    deadTimeParm.qVComp = DEADTIME_COMP_VOLTAGE;
+    deadTimeParm.qCurrentGain = (int16_t)(Q15(0.9999) / 
+                                            DEADTIME_COMP_CURRENT_BAND);
+    deadTimeParm.sign.a = 0;
+    deadTimeParm.sign.b = 0;
+    deadTimeParm.sign.c = 0;
+    deadTimeParm.valphabeta.alpha = 0;
+    deadTimeParm.valphabeta.beta = 0;
+    deadTimeParm.vabc.a = 0;
+    deadTimeParm.vabc.b = 0;
+    deadTimeParm.vabc.c = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    DeadTimeCompensate()
+
+  Summary:
+    Adds the dead time compensation voltage to the modulator input
+
+  Description:
+    During the dead time the phase voltage is set by the direction of the
+    phase current, so each leg loses qVComp of voltage in the direction of
+    its current. The loss is added to the voltage reference, with a sign
+    function that is linear within DEADTIME_COMP_CURRENT_BAND to avoid
+    switching the compensation on current ripple around zero crossings.
+    The compensation is transformed to the alpha-beta frame, without the
+    common mode component, and then to the frame of the space vector
+    modulation.
+
+  Precondition:
+    pVabc must be calculated with
+    MC_TransformClarkeInverseSwappedInput_Assembly().
+
+  Parameters:
+    pIabc - pointer to the measured phase currents
+    pVabc - pointer to the modulator input voltages
+
+  Returns:
+    None.
+
+  Remarks:
+    valphabeta is not modified, with the inverter error compensated it is
+    the voltage applied to the motor and remains the estimator input.
+ */
+void DeadTimeCompensate(const MC_ABC_T *pIabc, MC_ABC_T *pVabc)
+{
+    int16_t qVComp = deadTimeParm.qVComp;
+    int16_t tempint;
+
+    deadTimeParm.sign.a = DeadTimeSmoothSign(pIabc->a);
+    deadTimeParm.sign.b = DeadTimeSmoothSign(pIabc->b);
+    deadTimeParm.sign.c = DeadTimeSmoothSign(-pIabc->a - pIabc->b);
+
+    /* alpha = Vcomp * (2*a - b - c)/3 = Vcomp * (4/3) * (2*a - b - c)/4 */
+    tempint = (int16_t)((((int32_t)deadTimeParm.sign.a << 1) -
+                deadTimeParm.sign.b - deadTimeParm.sign.c) >> 2);
+    tempint = (int16_t)(__builtin_mulss(qVComp, tempint) >> 15);
+    deadTimeParm.valphabeta.alpha =
+                (int16_t)(__builtin_mulss(tempint, Q15(0.6667)) >> 14);
+
+    /* beta = Vcomp * (b - c)/sqrt(3) = Vcomp * (2/sqrt(3)) * (b - c)/2 */
+    tempint = (int16_t)(((int32_t)deadTimeParm.sign.b -
+                deadTimeParm.sign.c) >> 1);
+    tempint = (int16_t)(__builtin_mulss(qVComp, tempint) >> 15);
+    deadTimeParm.valphabeta.beta =
+                (int16_t)(__builtin_mulss(tempint, Q15(0.57735)) >> 14);
+
+    MC_TransformClarkeInverseSwappedInput_Assembly(&deadTimeParm.valphabeta,
+                                                   &deadTimeParm.vabc);
+
+    pVabc->a += deadTimeParm.vabc.a;
+    pVabc->b += deadTimeParm.vabc.b;
+    pVabc->c += deadTimeParm.vabc.c;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    DeadTimeSmoothSign()
+
+  Summary:
+    Sign of the current with a linear transition around zero
+
+  Description:
+    Returns the current multiplied by the gain, limited to +/-1.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qCurrent - phase current
+
+  Returns:
+    Smooth sign in Q15.
+
+  Remarks:
+    None.
+ */
+static int16_t DeadTimeSmoothSign(int16_t qCurrent)
+{
+    int32_t sign = __builtin_mulss(qCurrent, deadTimeParm.qCurrentGain);
+
+    if (sign > Q15(0.9999))
+    {
+        sign = Q15(0.9999);
+    }
+    else if (sign < Q15(-0.9999))
+    {
+        sign = Q15(-0.9999);
+    }
+    return (int16_t)sign;
+}
+
+// </editor-fold>
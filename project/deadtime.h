@@ -0,0 +1,95 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file deadtime.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the dead time and device voltage drop compensation
+ *
+ * Component: DEAD TIME COMPENSATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __DEADTIME_H
+#define __DEADTIME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Dead Time Compensation Parameter data type
+
+  Description:
+    This structure will host parameters related to the dead time and device
+    voltage drop compensation.
+ */
+typedef struct
+{
+    /* Compensation voltage of one inverter leg */
+    int16_t qVComp;
+    /* Gain of the smooth sign function, 1/current band */
+    int16_t qCurrentGain;
+    /* Smooth sign of the phase currents */
+    MC_ABC_T sign;
+    /* Compensation voltage in alpha-beta frame */
+    MC_ALPHABETA_T valphabeta;
+    /* Compensation voltage in the frame of the space vector modulation */
+    MC_ABC_T vabc;
+} DEADTIME_PARM_T;
+
+extern DEADTIME_PARM_T deadTimeParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitDeadTimeParams(void);
+void DeadTimeCompensate(const MC_ABC_T *pIabc, MC_ABC_T *pVabc);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEADTIME_H */
@@ -0,0 +1,168 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file decoupling.c
+ *
+ * @brief This module calculates the cross coupling and BEMF feed forward
+ * voltages of the d-q current controllers.
+ *
+ * Component: DECOUPLING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "decoupling.h"
+#include "estim.h"
+#include "general.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+DECOUPLING_PARM_T decouplingParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitDecouplingParams()
+
+  Summary:
+    Initializes decoupling parameters
+
+  Description:
+    This routine initializes the decoupling structure variables
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitDecouplingParams(void)
+{
+    decouplingParm.qOmegaDt = 0;
+    decouplingParm.qOmegaLs = 0;
+    decouplingParm.qVdFF = 0;
+    decouplingParm.qVqFF = 0;
+    decouplingParm.qVFFMax = DECOUPLING_VOLTAGE_MAX;
+}
+// *****************************************************************************
+
+/* Function:
+    DecouplingCalculate()
+
+  Summary:
+    Calculates the feed forward voltages of the current controllers
+
+  Description:
+    The rotating frame stator voltage equations are
+      Vd = Rs*Id + Ls*dId/dt - omega*Ls*Iq
+      Vq = Rs*Iq + Ls*dIq/dt + omega*Ls*Id + omega*Psi
+    The speed dependent terms are calculated with the inductance and the
+    BEMF constant of the estimator, so that the current controllers only
+    have to provide the resistive and inductive voltage drops.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qVelEstim - estimated electrical speed
+    pIdq      - pointer to the measured d-q currents
+
+  Returns:
+    None.
+
+  Remarks:
+    The BEMF voltage is obtained by inverting the speed calculation of the
+    estimator, omega = InvKFi * Esq * 2^NORM_INVKFIBASE_SCALE.
+ */
+void DecouplingCalculate(int16_t qVelEstim, const MC_DQ_T *pIdq)
+{
+    int16_t qDeltaRho;
+    int32_t vd, vq;
+
+    /* Angle increment per control cycle, same scaling as the estimator */
+    qDeltaRho = (int16_t)(__builtin_mulss(qVelEstim, NORM_DELTAT) >> 15);
+    /* 65536 counts are 2*pi radians, so omega*Ts in Q15 is qDeltaRho*pi,
+       calculated as qDeltaRho*(pi/4)*4 */
+    decouplingParm.qOmegaDt = (int16_t)(__builtin_mulss(qDeltaRho,
+                                        Q15(0.785398)) >> 13);
+    /* (Ls/Ts)*(omega*Ts) */
+    decouplingParm.qOmegaLs = (int16_t)(__builtin_mulss(motorParm.qLsDt,
+                                        decouplingParm.qOmegaDt) >> 15);
+
+    vd = -(__builtin_mulss(decouplingParm.qOmegaLs, pIdq->q)
+                                                >> NORM_LSDTBASE_SCALE_SHIFT);
+    vq = (__builtin_mulss(decouplingParm.qOmegaLs, pIdq->d)
+                                                >> NORM_LSDTBASE_SCALE_SHIFT) +
+            __builtin_divsd((int32_t)qVelEstim << (15 - NORM_INVKFIBASE_SCALE),
+                            motorParm.qInvKFi);
+
+    if (vd > decouplingParm.qVFFMax)
+    {
+        vd = decouplingParm.qVFFMax;
+    }
+    else if (vd < -decouplingParm.qVFFMax)
+    {
+        vd = -decouplingParm.qVFFMax;
+    }
+    if (vq > decouplingParm.qVFFMax)
+    {
+        vq = decouplingParm.qVFFMax;
+    }
+    else if (vq < -decouplingParm.qVFFMax)
+    {
+        vq = -decouplingParm.qVFFMax;
+    }
+    decouplingParm.qVdFF = (int16_t)vd;
+    decouplingParm.qVqFF = (int16_t)vq;
+}
+
+// </editor-fold>
@@ -0,0 +1,95 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file decoupling.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the current controller decoupling and BEMF feed forward
+ *
+ * Component: DECOUPLING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __DECOUPLING_H
+#define __DECOUPLING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Decoupling Parameter data type
+
+  Description:
+    This structure will host parameters related to the feed forward voltages
+    added to the outputs of the current controllers.
+ */
+typedef struct
+{
+    /* Electrical speed multiplied by the control period, Q15 radians */
+    int16_t qOmegaDt;
+    /* Electrical speed multiplied by Ls, scaled as motorParm.qLsDt */
+    int16_t qOmegaLs;
+    /* d-axis feed forward voltage */
+    int16_t qVdFF;
+    /* q-axis feed forward voltage */
+    int16_t qVqFF;
+    /* Feed forward voltage limit */
+    int16_t qVFFMax;
+} DECOUPLING_PARM_T;
+
+extern DECOUPLING_PARM_T decouplingParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitDecouplingParams(void);
+void DecouplingCalculate(int16_t qVelEstim, const MC_DQ_T *pIdq);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DECOUPLING_H */
@@ -52,6 +52,89 @@
 extern "C" {
 #endif
 
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "userparms.h"
+#include "timer1.h"
+
+// </editor-fold>
+
+#ifdef ISR_CYCLE_MEASUREMENT
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Execution time of the ADC ISR stages in instruction cycles */
+typedef struct
+{
+    /* Timer1 count at ISR entry */
+    uint16_t entry;
+    /* Timer1 count at the end of the previous stage */
+    uint16_t mark;
+    /* Current reconstruction, Clarke and Park transforms */
+    uint16_t current;
+    /* BEMF estimator */
+    uint16_t estim;
+    /* High frequency injection demodulation and tracking */
+    uint16_t hfi;
+    /* Speed reference and speed controller, with the notch filters */
+    uint16_t speed;
+    /* Notch filters and resonance detection */
+    uint16_t notch;
+    /* Control loops and park angle, after the notch filters if enabled */
+    uint16_t control;
+    /* Inverse transforms, space vector modulation and duty cycle update */
+    uint16_t modulation;
+    /* Measurements, board service and diagnostics */
+    uint16_t service;
+    /* Complete ISR */
+    uint16_t total;
+    /* Longest complete ISR since the counters were cleared */
+    uint16_t totalMax;
+} ISR_CYCLES_T;
+
+extern ISR_CYCLES_T isrCycles;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Marks the ISR entry */
+#define ISR_CYCLES_START()          DiagnosticsIsrCyclesStart()
+/* Stores the cycles elapsed since the previous mark in the given stage */
+#define ISR_CYCLES_STAGE(stage)     DiagnosticsIsrCyclesStage(&isrCycles.stage)
+/* Stores the cycles elapsed since the ISR entry */
+#define ISR_CYCLES_END()            DiagnosticsIsrCyclesEnd()
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INLINE FUNCTIONS ">
+inline static void DiagnosticsIsrCyclesStart(void)
+{
+    isrCycles.entry = TIMER1_COUNT;
+    isrCycles.mark = isrCycles.entry;
+}
+
+inline static void DiagnosticsIsrCyclesStage(uint16_t *pStage)
+{
+    uint16_t count = TIMER1_COUNT;
+    *pStage = count - isrCycles.mark;
+    isrCycles.mark = count;
+}
+
+inline static void DiagnosticsIsrCyclesEnd(void)
+{
+    isrCycles.total = TIMER1_COUNT - isrCycles.entry;
+    if (isrCycles.total > isrCycles.totalMax)
+    {
+        isrCycles.totalMax = isrCycles.total;
+    }
+}
+
+// </editor-fold>
+#else
+#define ISR_CYCLES_START()
+#define ISR_CYCLES_STAGE(stage)
+#define ISR_CYCLES_END()
+#endif
+
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 /**
  * Initializes diagnostics
@@ -51,6 +51,7 @@
 #include "X2CScope.h"
 #include "uart1.h"
 #include <stdint.h>
+#include "diagnostics.h"
 
 // </editor-fold>
 
@@ -60,6 +61,9 @@
 #define X2C_BAUDRATE_DIVIDER 54
 #define X2C_BUFFER_SIZE 4900
 X2C_DATA static uint8_t X2C_BUFFER[X2C_BUFFER_SIZE];
+#ifdef ISR_CYCLE_MEASUREMENT
+ISR_CYCLES_T isrCycles;
+#endif
     /*
      * baud rate = 100MHz/16/(1+baudrate_divider) for highspeed = false
      * baud rate = 100MHz/4/(1+baudrate_divider) for highspeed = true
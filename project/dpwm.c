@@ -0,0 +1,400 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file dpwm.c
+ *
+ * @brief This module implements discontinuous pulse width modulation, where
+ * one inverter leg is clamped for part of the electrical period to reduce the
+ * switching losses at high modulation index.
+ *
+ * Component: DISCONTINUOUS PWM
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "dpwm.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Duty cycle limits of the board service, the clamped leg is held here */
+#define DPWM_DUTY_MIN       (int16_t)(DEADTIME >> 1)
+#define DPWM_DUTY_MARGIN    (int16_t)(DEADTIME >> 1)
+/* Low side on time required for sampling the phase current shunts */
+#define DPWM_SAMPLE_WINDOW  (int16_t)(DPWM_SAMPLE_WINDOW_MICROSEC * \
+                                        LOOPTIME_TCY / LOOPTIME_MICROSEC)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+DPWM_PARM_T dpwmParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static int16_t DPWMMin3(int16_t a, int16_t b, int16_t c);
+static int16_t DPWMMax3(int16_t a, int16_t b, int16_t c);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitDPWMParams()
+
+  Summary:
+    Initializes discontinuous PWM parameters
+
+  Description:
+    This routine initializes the discontinuous PWM structure variables
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitDPWMParams(void)
+{
+    dpwmParm.mode = DPWM_SELECTED_MODE;
+    dpwmParm.activeMode = DPWM_CONTINUOUS;
+    dpwmParm.qOnThreshold = __builtin_mulss(DPWM_MODULATION_THRESHOLD,
+                                            DPWM_MODULATION_THRESHOLD);
+    dpwmParm.qOffThreshold = __builtin_mulss(
+            DPWM_MODULATION_THRESHOLD - DPWM_MODULATION_HYSTERESIS,
+            DPWM_MODULATION_THRESHOLD - DPWM_MODULATION_HYSTERESIS);
+    dpwmParm.offset = 0;
+    dpwmParm.shiftCount = 0;
+    dpwmParm.capCount = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    DPWMSelectMode()
+
+  Summary:
+    Selects continuous or discontinuous PWM from the modulation index
+
+  Description:
+    The discontinuous variant is used when the amplitude of the voltage
+    vector exceeds DPWM_MODULATION_THRESHOLD, the continuous space vector
+    modulation is restored when it falls below the threshold by more than
+    the hysteresis. The squares of the amplitudes are compared.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pVdq - pointer to the d-q voltages
+
+  Returns:
+    None.
+
+  Remarks:
+    At low modulation index the switching losses are small and the clamping
+    would only increase the current ripple.
+ */
+void DPWMSelectMode(const MC_DQ_T *pVdq)
+{
+    int32_t amplitude = __builtin_mulss(pVdq->d, pVdq->d) +
+                        __builtin_mulss(pVdq->q, pVdq->q);
+
+    if (amplitude > dpwmParm.qOnThreshold)
+    {
+        dpwmParm.activeMode = dpwmParm.mode;
+    }
+    else if (amplitude < dpwmParm.qOffThreshold)
+    {
+        dpwmParm.activeMode = DPWM_CONTINUOUS;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    DPWMCalculateOffset()
+
+  Summary:
+    Calculates the offset clamping one leg to the duty cycle limit
+
+  Description:
+    The space vector modulation centers the duty cycles in the PWM period.
+    Adding the same offset to all duty cycles changes only the zero sequence
+    voltage, the line voltages are not affected. The offset is chosen to
+    move the smallest duty cycle to the lower limit or the largest duty cycle
+    to the upper limit, the clamped leg does not switch in the PWM period.
+    For DPWM_1 the largest duty cycle is clamped if the middle one is below
+    the center of the other two, this is the phase with the largest voltage
+    magnitude.
+    In single shunt configuration no leg is clamped while the edges are
+    shifted between the halves of the period to open the measurement
+    windows, as the shifted legs switch anyway. These periods are counted in
+    dpwmParm.shiftCount.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pDuty1 - pointer to the duty cycles of the first half of the period
+    pDuty2 - pointer to the duty cycles of the second half of the period
+    iPwmPeriod - PWM period
+
+  Returns:
+    Offset to be added to all duty cycles.
+
+  Remarks:
+    With center aligned PWM both pointers refer to the same duty cycles.
+    Without single shunt, the legs with the phase current shunts
+    (duty cycles 1 and 2) need DPWM_SAMPLE_WINDOW of low side on time for
+    sampling the currents. When clamping the largest duty cycle would reduce
+    it below this window, the smallest duty cycle is clamped to the lower
+    limit instead, these periods are counted in dpwmParm.capCount.
+ */
+int16_t DPWMCalculateOffset(const MC_DUTYCYCLEOUT_T *pDuty1,
+                        const MC_DUTYCYCLEOUT_T *pDuty2, uint16_t iPwmPeriod)
+{
+    int16_t dutyMin, dutyMax, dutyMid, offset = 0;
+    int16_t dutyA = (int16_t)((pDuty1->dutycycle1 >> 1) + 
+                              (pDuty2->dutycycle1 >> 1));
+    int16_t dutyB = (int16_t)((pDuty1->dutycycle2 >> 1) + 
+                              (pDuty2->dutycycle2 >> 1));
+    int16_t dutyC = (int16_t)((pDuty1->dutycycle3 >> 1) + 
+                              (pDuty2->dutycycle3 >> 1));
+    DPWM_MODE mode = dpwmParm.activeMode;
+
+#ifdef SINGLE_SHUNT
+    if ((mode != DPWM_CONTINUOUS) &&
+        ((pDuty1->dutycycle1 != pDuty2->dutycycle1) ||
+         (pDuty1->dutycycle2 != pDuty2->dutycycle2) ||
+         (pDuty1->dutycycle3 != pDuty2->dutycycle3)))
+    {
+        /* Measurement window shift active */
+        mode = DPWM_CONTINUOUS;
+        if (dpwmParm.shiftCount < UINT16_MAX)
+        {
+            dpwmParm.shiftCount++;
+        }
+    }
+#endif
+
+    if (mode == DPWM_1)
+    {
+        dutyMin = DPWMMin3(dutyA, dutyB, dutyC);
+        dutyMax = DPWMMax3(dutyA, dutyB, dutyC);
+        dutyMid = dutyA + dutyB + dutyC - dutyMin - dutyMax;
+        if ((dutyMax - dutyMid) > (dutyMid - dutyMin))
+        {
+            mode = DPWM_MAX;
+        }
+        else
+        {
+            mode = DPWM_MIN;
+        }
+    }
+
+    if (mode == DPWM_MAX)
+    {
+        /* Largest of the duty cycles of both halves */
+        dutyMax = DPWMMax3(pDuty1->dutycycle1, pDuty1->dutycycle2,
+                                                    pDuty1->dutycycle3);
+        dutyMid = DPWMMax3(pDuty2->dutycycle1, pDuty2->dutycycle2,
+                                                    pDuty2->dutycycle3);
+        if (dutyMid > dutyMax)
+        {
+            dutyMax = dutyMid;
+        }
+        offset = (int16_t)iPwmPeriod - DPWM_DUTY_MARGIN - dutyMax;
+        if (offset < 0)
+        {
+            offset = 0;
+        }
+#ifndef SINGLE_SHUNT
+        /* Keep the sampling window of the shunt legs */
+        dutyMax = (dutyA > dutyB) ? dutyA : dutyB;
+        if (offset > ((int16_t)iPwmPeriod - DPWM_SAMPLE_WINDOW - dutyMax))
+        {
+            mode = DPWM_MIN;
+            if (dpwmParm.capCount < UINT16_MAX)
+            {
+                dpwmParm.capCount++;
+            }
+        }
+#endif
+    }
+    if (mode == DPWM_MIN)
+    {
+        /* Smallest of the duty cycles of both halves */
+        dutyMin = DPWMMin3(pDuty1->dutycycle1, pDuty1->dutycycle2,
+                                                    pDuty1->dutycycle3);
+        dutyMid = DPWMMin3(pDuty2->dutycycle1, pDuty2->dutycycle2,
+                                                    pDuty2->dutycycle3);
+        if (dutyMid < dutyMin)
+        {
+            dutyMin = dutyMid;
+        }
+        offset = DPWM_DUTY_MIN - dutyMin;
+    }
+    dpwmParm.offset = offset;
+    return offset;
+}
+// *****************************************************************************
+
+/* Function:
+    DPWMClamp()
+
+  Summary:
+    Applies the discontinuous PWM to center aligned duty cycles
+
+  Description:
+    The offset calculated by DPWMCalculateOffset() is added to the duty
+    cycles.
+
+  Precondition:
+    The duty cycles must be calculated with
+    MC_CalculateSpaceVectorPhaseShifted_Assembly().
+
+  Parameters:
+    pDuty - pointer to the duty cycles
+    iPwmPeriod - PWM period
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void DPWMClamp(MC_DUTYCYCLEOUT_T *pDuty, uint16_t iPwmPeriod)
+{
+    int16_t offset = DPWMCalculateOffset(pDuty, pDuty, iPwmPeriod);
+
+    pDuty->dutycycle1 += offset;
+    pDuty->dutycycle2 += offset;
+    pDuty->dutycycle3 += offset;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    DPWMMin3()
+
+  Summary:
+    Smallest of three values
+
+  Description:
+    Returns the smallest of the three values.
+
+  Precondition:
+    None.
+
+  Parameters:
+    a, b, c - values
+
+  Returns:
+    Smallest value.
+
+  Remarks:
+    None.
+ */
+static int16_t DPWMMin3(int16_t a, int16_t b, int16_t c)
+{
+    int16_t min = a;
+
+    if (b < min)
+    {
+        min = b;
+    }
+    if (c < min)
+    {
+        min = c;
+    }
+    return min;
+}
+// *****************************************************************************
+
+/* Function:
+    DPWMMax3()
+
+  Summary:
+    Largest of three values
+
+  Description:
+    Returns the largest of the three values.
+
+  Precondition:
+    None.
+
+  Parameters:
+    a, b, c - values
+
+  Returns:
+    Largest value.
+
+  Remarks:
+    None.
+ */
+static int16_t DPWMMax3(int16_t a, int16_t b, int16_t c)
+{
+    int16_t max = a;
+
+    if (b > max)
+    {
+        max = b;
+    }
+    if (c > max)
+    {
+        max = c;
+    }
+    return max;
+}
+
+// </editor-fold>
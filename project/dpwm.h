@@ -0,0 +1,115 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file dpwm.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the discontinuous pulse width modulation
+ *
+ * Component: DISCONTINUOUS PWM
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __DPWM_H
+#define __DPWM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Discontinuous modulation variants */
+typedef enum tagDPWM_MODE
+{
+    DPWM_CONTINUOUS = 0,    /* Space vector modulation, no clamping */
+    DPWM_MIN = 1,           /* Smallest duty cycle clamped to the lower limit */
+    DPWM_MAX = 2,           /* Largest duty cycle clamped to the upper limit */
+    DPWM_1 = 3              /* Phase with the largest voltage clamped to its 
+                               limit, 60 degree clamps centered on the peaks */
+} DPWM_MODE;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Discontinuous PWM Parameter data type
+
+  Description:
+    This structure will host parameters related to the discontinuous PWM.
+ */
+typedef struct
+{
+    /* Discontinuous variant used above the modulation threshold */
+    DPWM_MODE mode;
+    /* Variant in use: mode or DPWM_CONTINUOUS */
+    DPWM_MODE activeMode;
+    /* Square of the voltage amplitude enabling the discontinuous PWM */
+    int32_t qOnThreshold;
+    /* Square of the voltage amplitude returning to continuous PWM */
+    int32_t qOffThreshold;
+    /* Offset added to all duty cycles */
+    int16_t offset;
+    /* PWM periods not clamped because of the single shunt window shift */
+    uint16_t shiftCount;
+    /* PWM periods with the smallest instead of the largest duty cycle 
+       clamped, for the sampling window of the shunt legs */
+    uint16_t capCount;
+} DPWM_PARM_T;
+
+extern DPWM_PARM_T dpwmParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitDPWMParams(void);
+void DPWMSelectMode(const MC_DQ_T *pVdq);
+int16_t DPWMCalculateOffset(const MC_DUTYCYCLEOUT_T *pDuty1,
+                        const MC_DUTYCYCLEOUT_T *pDuty2, uint16_t iPwmPeriod);
+void DPWMClamp(MC_DUTYCYCLEOUT_T *pDuty, uint16_t iPwmPeriod);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DPWM_H */
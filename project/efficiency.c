@@ -0,0 +1,313 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file efficiency.c
+ *
+ * @brief This module searches the d current offset with the lowest electrical
+ * input power at light load and steady speed, by perturb and observe, and
+ * holds it once the search has converged.
+ *
+ * Component: EFFICIENCY OPTIMIZATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include "efficiency.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+#include "mtpa.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* q current below which the search runs */
+#define EFFICIENCY_IQ_MAX       NORM_CURRENT(EFFICIENCY_LOAD_CURRENT)
+/* d current step and largest d current offset */
+#define EFFICIENCY_STEP         NORM_CURRENT(EFFICIENCY_ID_STEP)
+#define EFFICIENCY_OFFSET_MAX   NORM_CURRENT(EFFICIENCY_ID_MAX)
+/* Control cycles of the settling time and of the power window */
+#define EFFICIENCY_SETTLE_COUNT (uint16_t)(EFFICIENCY_SETTLE_TIME_SEC/ \
+                                    LOOPTIME_SEC)
+#define EFFICIENCY_WINDOW_COUNT (uint16_t)(1UL << EFFICIENCY_WINDOW_SHIFT)
+/* Smallest input power decrease taken as an improvement */
+#define EFFICIENCY_DEADBAND     Q15(EFFICIENCY_POWER_DEADBAND)
+/* Speed reference change which restarts the search */
+#define EFFICIENCY_SPEED_BAND   (int16_t)(EFFICIENCY_SPEED_BAND_RPM*POLE_PAIRS)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+EFFICIENCY_PARM_T efficiencyParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    EfficiencyStart()
+
+  Summary:
+    Starts a new search
+
+  Description:
+    This routine starts the search from the present d current offset,
+    towards a negative offset when there is none.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qVelRef - Speed reference
+
+  Returns:
+    None.
+
+  Remarks:
+    The power of the previous operating point is not compared.
+ */
+static void EfficiencyStart(int16_t qVelRef)
+{
+    efficiencyParm.state = EFFICIENCY_STATE_SETTLE;
+    efficiencyParm.count = EFFICIENCY_SETTLE_COUNT;
+    efficiencyParm.qVelRef = qVelRef;
+    if (efficiencyParm.qIdOffset == 0)
+    {
+        efficiencyParm.direction = -1;
+    }
+    efficiencyParm.powerValid = 0;
+    efficiencyParm.qPowerBest = INT16_MAX;
+    efficiencyParm.qIdOffsetBest = efficiencyParm.qIdOffset;
+    efficiencyParm.reversals = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    EfficiencyStep()
+
+  Summary:
+    Perturb and observe step
+
+  Description:
+    This routine compares the mean input power of the last window with the
+    previous one. The d current keeps moving in the same direction while the
+    power decreases by more than EFFICIENCY_POWER_DEADBAND and reverses
+    otherwise, or at the largest offset. After EFFICIENCY_REVERSALS reversals
+    the offset with the lowest power is held.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+static void EfficiencyStep(void)
+{
+    int16_t offset;
+
+    if (efficiencyParm.qPower < efficiencyParm.qPowerBest)
+    {
+        efficiencyParm.qPowerBest = efficiencyParm.qPower;
+        efficiencyParm.qIdOffsetBest = efficiencyParm.qIdOffset;
+    }
+    if ((efficiencyParm.powerValid != 0) &&
+        ((int32_t)efficiencyParm.qPower >
+         (int32_t)efficiencyParm.qPowerPrevious - EFFICIENCY_DEADBAND))
+    {
+        efficiencyParm.direction = -efficiencyParm.direction;
+        efficiencyParm.reversals++;
+    }
+    efficiencyParm.qPowerPrevious = efficiencyParm.qPower;
+    efficiencyParm.powerValid = 1;
+
+    offset = efficiencyParm.qIdOffset +
+             efficiencyParm.direction*EFFICIENCY_STEP;
+    if ((offset > EFFICIENCY_OFFSET_MAX) || (offset < -EFFICIENCY_OFFSET_MAX))
+    {
+        efficiencyParm.direction = -efficiencyParm.direction;
+        efficiencyParm.reversals++;
+        offset = efficiencyParm.qIdOffset +
+                 efficiencyParm.direction*EFFICIENCY_STEP;
+    }
+
+    if (efficiencyParm.reversals >= EFFICIENCY_REVERSALS)
+    {
+        efficiencyParm.qIdOffset = efficiencyParm.qIdOffsetBest;
+        efficiencyParm.state = EFFICIENCY_STATE_HOLD;
+    }
+    else
+    {
+        efficiencyParm.qIdOffset = offset;
+        efficiencyParm.state = EFFICIENCY_STATE_SETTLE;
+        efficiencyParm.count = EFFICIENCY_SETTLE_COUNT;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    EfficiencyReset()
+
+  Summary:
+    Ends the search
+
+  Description:
+    This routine removes the d current offset, the search starts again when
+    the load and speed are in its range.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called when the control is reinitialized.
+ */
+void EfficiencyReset(void)
+{
+    efficiencyParm.state = EFFICIENCY_STATE_IDLE;
+    efficiencyParm.qIdOffset = 0;
+    efficiencyParm.direction = -1;
+    efficiencyParm.count = 0;
+    efficiencyParm.powerSum = 0;
+    efficiencyParm.qPower = 0;
+    efficiencyParm.powerValid = 0;
+    efficiencyParm.reversals = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    EfficiencySearch()
+
+  Summary:
+    Searches the d current offset with the lowest input power
+
+  Description:
+    This routine calculates the electrical input power vd*id + vq*iq and
+    averages it over 2^EFFICIENCY_WINDOW_SHIFT control cycles, after
+    EFFICIENCY_SETTLE_TIME_SEC for the speed controller to settle at each
+    d current step. At constant speed and load the shaft power is constant,
+    so the offset with the lowest input power has the lowest losses.
+    The search runs while the q current reference is below
+    EFFICIENCY_LOAD_CURRENT and, with MTPA, the field is not weakened, the
+    offset is removed otherwise. It is restarted from the present offset
+    when the speed reference moves by more than EFFICIENCY_SPEED_BAND_RPM.
+
+  Precondition:
+    EfficiencyReset() is called before.
+
+  Parameters:
+    qVelRef - Speed reference
+    qIqRef  - q current reference
+    pVdq    - Output voltage vector of the last control cycle
+    pIdq    - Measured d-q currents
+
+  Returns:
+    d current offset.
+
+  Remarks:
+    Called in closed loop every control cycle.
+ */
+int16_t EfficiencySearch(int16_t qVelRef, int16_t qIqRef, const MC_DQ_T *pVdq,
+                         const MC_DQ_T *pIdq)
+{
+    int16_t speedChange;
+
+    if ((qIqRef > EFFICIENCY_IQ_MAX) || (qIqRef < -EFFICIENCY_IQ_MAX)
+#ifdef MTPA
+        || (mtpaParm.qIdFw != 0)
+#endif
+       )
+    {
+        EfficiencyReset();
+        return 0;
+    }
+
+    speedChange = qVelRef - efficiencyParm.qVelRef;
+    if ((efficiencyParm.state == EFFICIENCY_STATE_IDLE) ||
+        (speedChange > EFFICIENCY_SPEED_BAND) ||
+        (speedChange < -EFFICIENCY_SPEED_BAND))
+    {
+        EfficiencyStart(qVelRef);
+    }
+
+    switch (efficiencyParm.state)
+    {
+        case EFFICIENCY_STATE_SETTLE:
+            efficiencyParm.count--;
+            if (efficiencyParm.count == 0)
+            {
+                efficiencyParm.powerSum = 0;
+                efficiencyParm.count = EFFICIENCY_WINDOW_COUNT;
+                efficiencyParm.state = EFFICIENCY_STATE_MEASURE;
+            }
+            break;
+        case EFFICIENCY_STATE_MEASURE:
+            efficiencyParm.powerSum += (__builtin_mulss(pVdq->d, pIdq->d) +
+                                        __builtin_mulss(pVdq->q, pIdq->q)) >> 15;
+            efficiencyParm.count--;
+            if (efficiencyParm.count == 0)
+            {
+                efficiencyParm.qPower = (int16_t)(efficiencyParm.powerSum >>
+                                                  EFFICIENCY_WINDOW_SHIFT);
+                EfficiencyStep();
+            }
+            break;
+        default:
+            break;
+    }
+
+    return efficiencyParm.qIdOffset;
+}
+
+// </editor-fold>
@@ -0,0 +1,125 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file efficiency.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the loss minimization search of the d current at light load
+ *
+ * Component: EFFICIENCY OPTIMIZATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __EFFICIENCY_H
+#define __EFFICIENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Efficiency search state data type
+
+  Description:
+    Progress of the loss minimization search.
+ */
+typedef enum
+{
+    /* Load or speed outside the search range, no d current offset */
+    EFFICIENCY_STATE_IDLE = 0,
+    /* Waiting for the drive to settle after a d current step */
+    EFFICIENCY_STATE_SETTLE = 1,
+    /* Averaging the input power */
+    EFFICIENCY_STATE_MEASURE = 2,
+    /* Search converged, the d current offset is held */
+    EFFICIENCY_STATE_HOLD = 3
+} EFFICIENCY_STATE_T;
+
+/* Efficiency Optimization Parameter data type
+
+  Description:
+    This structure will host parameters related to the perturb and observe
+    search of the d current offset with the lowest electrical input power.
+ */
+typedef struct
+{
+    /* Progress of the search */
+    EFFICIENCY_STATE_T state;
+    /* d current offset added to the d current reference */
+    int16_t qIdOffset;
+    /* Direction of the next d current step, +1 or -1 */
+    int16_t direction;
+    /* Speed reference the search was started at */
+    int16_t qVelRef;
+    /* Control cycles left in the settling time or the power window */
+    uint16_t count;
+    /* Sum of the input power over the window */
+    int32_t powerSum;
+    /* Mean input power of the last and of the previous window */
+    int16_t qPower;
+    int16_t qPowerPrevious;
+    /* Nonzero when qPowerPrevious is valid */
+    uint16_t powerValid;
+    /* Lowest mean input power of the search and its d current offset */
+    int16_t qPowerBest;
+    int16_t qIdOffsetBest;
+    /* Consecutive direction reversals */
+    uint16_t reversals;
+} EFFICIENCY_PARM_T;
+
+extern EFFICIENCY_PARM_T efficiencyParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void EfficiencyReset(void);
+int16_t EfficiencySearch(int16_t qVelRef, int16_t qIqRef, const MC_DQ_T *pVdq,
+                         const MC_DQ_T *pIdq);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFFICIENCY_H */
@@ -301,11 +301,11 @@ void InitEstimParm(void)
 {
     /* Constants are defined in usreparms.h */
 
-    motorParm.qLsDtBase = NORM_LSDTBASE;
+    motorParm.qLsDtBase = NORM_VOLTAGE_SCALE(NORM_LSDTBASE);
     motorParm.qLsDt = motorParm.qLsDtBase;
-    motorParm.qRs = NORM_RS;
+    motorParm.qRs = NORM_VOLTAGE_SCALE(NORM_RS);
 
-    motorParm.qInvKFiBase = NORM_INVKFIBASE;
+    motorParm.qInvKFiBase = NORM_VOLTAGE_INV_SCALE(NORM_INVKFIBASE);
     motorParm.qInvKFi = motorParm.qInvKFiBase;
 
     estimator.qRhoStateVar = 0;
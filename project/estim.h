@@ -150,6 +150,7 @@ typedef struct
 
 extern ESTIM_PARM_T estimator;
 extern MOTOR_ESTIM_PARM_T motorParm;
+extern MC_ALPHABETA_T bemfAlphaBeta;
 
 // </editor-fold>
 
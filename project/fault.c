@@ -0,0 +1,777 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file fault.c
+ *
+ * @brief This module implements the software detection of overcurrent, stall,
+ * phase loss and DC bus over and under voltage, and the reactions to the
+ * detected faults.
+ *
+ * Component: FAULT DETECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "fault.h"
+#include "restart.h"
+#include "general.h"
+#include "userparms.h"
+#include "estim.h"
+#include "pwm.h"
+#include "board_service.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Overcurrent level below the hardware comparator threshold */
+#define FAULT_OC_LEVEL          (int16_t)(Q15_OVER_CURRENT_THRESHOLD* \
+                                    FAULT_OVERCURRENT_LEVEL)
+
+/* Control cycles in the phase loss window */
+#define FAULT_WINDOW_COUNT      1024
+/* The squared phase currents are summed with FAULT_WINDOW_SHIFT fractional
+   bits less, so that the sums of the window fit in 31 bits */
+#define FAULT_WINDOW_SHIFT      10
+/* Speed with two electrical periods in the window, below it the squared
+   currents of the window do not represent the phase current amplitudes */
+#define FAULT_PHASE_LOSS_SPEED  (int16_t)(2.0*60.0/ \
+                                    (FAULT_WINDOW_COUNT*LOOPTIME_SEC))
+/* Minimum sum of the window of the phase with the largest current */
+#define FAULT_PHASE_LOSS_SUM    (int32_t)(FAULT_WINDOW_COUNT/2.0* \
+                                    NORM_CURRENT(FAULT_PHASE_LOSS_CURRENT)* \
+                                    NORM_CURRENT(FAULT_PHASE_LOSS_CURRENT)/ \
+                                    (1 << FAULT_WINDOW_SHIFT))
+
+/* Stall detection time in control cycles, the speed below which a saturated
+   speed controller is a stall and the allowed speed difference in Q15 */
+#define FAULT_STALL_COUNT       (uint16_t)(FAULT_STALL_TIME_SEC/LOOPTIME_SEC)
+#define FAULT_STALL_MIN_SPEED   (ENDSPEED_ELECTR/2)
+#define FAULT_STALL_ERROR       Q15(FAULT_STALL_SPEED_ERROR)
+
+/* Bus voltage levels with hysteresis and the filter time in control cycles */
+#define FAULT_OV_SET            Q15(FAULT_OVERVOLTAGE_SET/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+#define FAULT_OV_CLEAR          Q15(FAULT_OVERVOLTAGE_CLEAR/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+#define FAULT_UV_SET            Q15(FAULT_UNDERVOLTAGE_SET/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+#define FAULT_UV_CLEAR          Q15(FAULT_UNDERVOLTAGE_CLEAR/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+#define FAULT_VOLTAGE_COUNT     (uint16_t)(FAULT_VOLTAGE_TIME_SEC/LOOPTIME_SEC)
+
+/* Brake time in control cycles */
+#define FAULT_BRAKE_COUNT       (uint32_t)(FAULT_BRAKE_TIME_SEC/LOOPTIME_SEC)
+
+/* Faults preventing the start of the motor while they are present */
+#define FAULT_VOLTAGE_MASK      (FAULT_OVERVOLTAGE | FAULT_UNDERVOLTAGE)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+FAULT_PARM_T faultParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static void FaultDetectPhaseLoss(void);
+static void FaultTrip(void);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitFaultParams()
+
+  Summary:
+    Initializes fault detection parameters
+
+  Description:
+    This routine clears the faults and the reaction, and initializes the
+    restart policy.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the bus voltage is supervised while the motor is
+    stopped.
+ */
+void InitFaultParams(void)
+{
+    faultParm.active = 0;
+    faultParm.lastFault = 0;
+    faultParm.lastClass = 0;
+    faultParm.reaction = FAULT_REACTION_COAST;
+    faultParm.state = FAULT_STATE_NONE;
+    faultParm.action = FAULT_ACTION_NONE;
+    faultParm.delayCount = 0;
+    faultParm.overvoltageCount = 0;
+    faultParm.undervoltageCount = 0;
+    FaultReset();
+    InitRestartParams();
+}
+// *****************************************************************************
+
+/* Function:
+    FaultReset()
+
+  Summary:
+    Resets the detectors of the running motor
+
+  Description:
+    This routine clears the overcurrent, stall and phase loss detectors and
+    their faults before the motor is started.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    The bus voltage faults and the fault reaction are kept.
+ */
+void FaultReset(void)
+{
+    faultParm.active &= FAULT_VOLTAGE_MASK;
+    faultParm.overcurrentCount = 0;
+    faultParm.stallCount = 0;
+    faultParm.qVelBemf = 0;
+    faultParm.sumIa = 0;
+    faultParm.sumIb = 0;
+    faultParm.sumIc = 0;
+    faultParm.windowCount = 0;
+    faultParm.phaseLossCount = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    FaultDetectCurrent()
+
+  Summary:
+    Detects overcurrent and phase loss
+
+  Description:
+    Overcurrent - the largest phase current magnitude exceeds
+    FAULT_OVERCURRENT_LEVEL of the hardware comparator threshold for
+    FAULT_OVERCURRENT_COUNT consecutive control cycles.
+    Phase loss - the squared phase currents are summed over
+    FAULT_WINDOW_COUNT control cycles. If the sum of one phase is less than
+    1/FAULT_PHASE_LOSS_RATIO of the largest sum for FAULT_PHASE_LOSS_WINDOWS
+    consecutive windows, that phase carries no current.
+
+  Precondition:
+    Called once every control cycle while the motor runs.
+
+  Parameters:
+    pIabc - pointer to the measured phase currents a and b
+    qVel - speed of the rotor, zero if not known
+
+  Returns:
+    None.
+
+  Remarks:
+    The phase loss windows are evaluated only above FAULT_PHASE_LOSS_SPEED,
+    at standstill a single phase may carry no current at a valid angle.
+ */
+void FaultDetectCurrent(const MC_ABC_T *pIabc, int16_t qVel)
+{
+    int16_t ia = pIabc->a;
+    int16_t ib = pIabc->b;
+    int16_t ic = -ia - ib;
+    int16_t imax;
+
+    /* Overcurrent */
+    imax = _Q15abs(ia);
+    if (_Q15abs(ib) > imax)
+    {
+        imax = _Q15abs(ib);
+    }
+    if (_Q15abs(ic) > imax)
+    {
+        imax = _Q15abs(ic);
+    }
+    if (imax > FAULT_OC_LEVEL)
+    {
+        faultParm.overcurrentCount++;
+        if (faultParm.overcurrentCount >= FAULT_OVERCURRENT_COUNT)
+        {
+            faultParm.active |= FAULT_OVERCURRENT;
+        }
+    }
+    else
+    {
+        faultParm.overcurrentCount = 0;
+    }
+
+    /* Phase loss */
+    faultParm.sumIa += __builtin_mulss(ia, ia) >> FAULT_WINDOW_SHIFT;
+    faultParm.sumIb += __builtin_mulss(ib, ib) >> FAULT_WINDOW_SHIFT;
+    faultParm.sumIc += __builtin_mulss(ic, ic) >> FAULT_WINDOW_SHIFT;
+    faultParm.windowCount++;
+    if (faultParm.windowCount >= FAULT_WINDOW_COUNT)
+    {
+        if (_Q15abs(qVel) > FAULT_PHASE_LOSS_SPEED)
+        {
+            FaultDetectPhaseLoss();
+        }
+        else
+        {
+            faultParm.phaseLossCount = 0;
+        }
+        faultParm.sumIa = 0;
+        faultParm.sumIb = 0;
+        faultParm.sumIc = 0;
+        faultParm.windowCount = 0;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    FaultDetectStall()
+
+  Summary:
+    Detects a stalled rotor or a loss of the estimator lock
+
+  Description:
+    The speed is also calculated from the magnitude of the estimated BEMF.
+    While the speed controller output is saturated, the rotor is stalled if
+    the estimated speed is below half the open loop end speed or if it
+    differs from the BEMF speed by more than FAULT_STALL_SPEED_ERROR.
+    The stall counter counts up while stalled and down otherwise, so that
+    intermittent conditions are integrated, and the fault is set after
+    FAULT_STALL_TIME_SEC.
+
+  Precondition:
+    Called once every control cycle in closed loop speed control.
+
+  Parameters:
+    qVel - estimated speed
+    qEsd - filtered d-axis BEMF
+    qEsq - filtered q-axis BEMF
+    saturated - nonzero if the speed controller output is at its limit
+
+  Returns:
+    None.
+
+  Remarks:
+    The BEMF magnitude is approximated by max + 3/8 min of the component
+    magnitudes, within 7% of the exact value.
+ */
+void FaultDetectStall(int16_t qVel, int16_t qEsd, int16_t qEsq,
+                      uint16_t saturated)
+{
+    int16_t esMax, esMin;
+    int32_t magnitude, speed, error;
+
+    esMax = _Q15abs(qEsq);
+    esMin = _Q15abs(qEsd);
+    if (esMin > esMax)
+    {
+        esMax = esMin;
+        esMin = _Q15abs(qEsq);
+    }
+    magnitude = (int32_t)esMax + (esMin >> 2) + (esMin >> 3);
+    if (magnitude > INT16_MAX)
+    {
+        magnitude = INT16_MAX;
+    }
+    speed = (__builtin_mulss(motorParm.qInvKFi, (int16_t)magnitude) >> 15) <<
+                                                        NORM_INVKFIBASE_SCALE;
+    if (speed > INT16_MAX)
+    {
+        speed = INT16_MAX;
+    }
+    faultParm.qVelBemf = (int16_t)speed;
+
+    if (saturated != 0)
+    {
+        speed = _Q15abs(qVel);
+        error = faultParm.qVelBemf - speed;
+        if (error < 0)
+        {
+            error = -error;
+        }
+        if ((speed < FAULT_STALL_MIN_SPEED) ||
+            (error > (__builtin_mulss((int16_t)speed, FAULT_STALL_ERROR) >> 15)))
+        {
+            faultParm.stallCount++;
+            if (faultParm.stallCount >= FAULT_STALL_COUNT)
+            {
+                faultParm.active |= FAULT_STALL;
+            }
+            return;
+        }
+    }
+    if (faultParm.stallCount > 0)
+    {
+        faultParm.stallCount--;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    FaultDetectVoltage()
+
+  Summary:
+    Detects DC bus over and under voltage
+
+  Description:
+    A fault is set when the bus voltage is beyond its set level for
+    FAULT_VOLTAGE_TIME_SEC, and is cleared when the bus voltage is back
+    within the clear level.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    qVdc - DC bus voltage, spikes removed
+
+  Returns:
+    None.
+
+  Remarks:
+    The bus voltage is supervised also while the motor is stopped, the motor
+    is not started while a bus voltage fault is present.
+ */
+void FaultDetectVoltage(int16_t qVdc)
+{
+    if (qVdc > FAULT_OV_SET)
+    {
+        if (faultParm.overvoltageCount < FAULT_VOLTAGE_COUNT)
+        {
+            faultParm.overvoltageCount++;
+        }
+        else
+        {
+            faultParm.active |= FAULT_OVERVOLTAGE;
+        }
+    }
+    else if (qVdc < FAULT_OV_CLEAR)
+    {
+        faultParm.overvoltageCount = 0;
+        faultParm.active &= ~FAULT_OVERVOLTAGE;
+    }
+
+    if (qVdc < FAULT_UV_SET)
+    {
+        if (faultParm.undervoltageCount < FAULT_VOLTAGE_COUNT)
+        {
+            faultParm.undervoltageCount++;
+        }
+        else
+        {
+            faultParm.active |= FAULT_UNDERVOLTAGE;
+        }
+    }
+    else if (qVdc > FAULT_UV_CLEAR)
+    {
+        faultParm.undervoltageCount = 0;
+        faultParm.active &= ~FAULT_UNDERVOLTAGE;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    FaultStepIsr()
+
+  Summary:
+    Executes the fault reaction
+
+  Description:
+    A fault present while the motor runs trips the drive with the reaction
+    configured for the fault. The PWM outputs are disabled at once, or for
+    the brake reaction after FAULT_BRAKE_TIME_SEC with the low side switches
+    on. The main loop is then requested to reinitialize the control.
+    The restart policy decides whether and after which delay the motor is
+    started again, otherwise the fault is latched until the motor is started
+    by the user.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    running - nonzero if the motor runs
+
+  Returns:
+    Nonzero if the motor must be stopped.
+
+  Remarks:
+    While the motor is stopped with the PWM outputs enabled, all legs are
+    driven with the minimum duty cycle, the zero vector of the brake.
+ */
+uint16_t FaultStepIsr(uint16_t running)
+{
+    RestartStepIsr(running && (faultParm.active == 0));
+
+    switch (faultParm.state)
+    {
+        case FAULT_STATE_NONE:
+            if ((running != 0) && (faultParm.active != 0))
+            {
+                FaultTrip();
+                return 1;
+            }
+        break;
+
+        case FAULT_STATE_BRAKE:
+            faultParm.delayCount--;
+            if (faultParm.delayCount == 0)
+            {
+                DisablePWMOutputs();
+                faultParm.state = FAULT_STATE_STOP;
+            }
+        break;
+
+        case FAULT_STATE_STOP:
+            faultParm.action = FAULT_ACTION_RESET;
+            faultParm.delayCount = RestartPolicy(faultParm.lastClass);
+            if (faultParm.delayCount != 0)
+            {
+                faultParm.state = FAULT_STATE_WAIT;
+            }
+            else
+            {
+                faultParm.state = FAULT_STATE_LATCHED;
+            }
+        break;
+
+        case FAULT_STATE_WAIT:
+            if (faultParm.delayCount > 0)
+            {
+                faultParm.delayCount--;
+            }
+            else if (((faultParm.active & FAULT_VOLTAGE_MASK) == 0) &&
+                     (faultParm.action == FAULT_ACTION_NONE))
+            {
+                RestartExecuted();
+                faultParm.state = FAULT_STATE_NONE;
+                faultParm.action = FAULT_ACTION_RESTART;
+            }
+        break;
+
+        default:
+        break;
+    }
+    return 0;
+}
+// *****************************************************************************
+
+/* Function:
+    FaultStepMain()
+
+  Summary:
+    Returns the request of the fault reaction to the main loop
+
+  Description:
+    The control is reinitialized by ResetParmeters() from the main loop, as
+    it disables the ADC interrupt.
+
+  Precondition:
+    Called from the main loop.
+
+  Parameters:
+    None
+
+  Returns:
+    FAULT_ACTION_RESET to reinitialize the control, FAULT_ACTION_RESTART to
+    reinitialize the control and start the motor.
+
+  Remarks:
+    None.
+ */
+FAULT_ACTION_T FaultStepMain(void)
+{
+    FAULT_ACTION_T action = faultParm.action;
+
+    faultParm.action = FAULT_ACTION_NONE;
+    return action;
+}
+// *****************************************************************************
+
+/* Function:
+    FaultStartAllowed()
+
+  Summary:
+    Checks if the motor can be started
+
+  Description:
+    The motor is not started while braking and while a bus voltage fault is
+    present.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    Nonzero if the motor can be started.
+
+  Remarks:
+    None.
+ */
+uint16_t FaultStartAllowed(void)
+{
+    if ((faultParm.state == FAULT_STATE_BRAKE) ||
+        (faultParm.state == FAULT_STATE_STOP) ||
+        ((faultParm.active & FAULT_VOLTAGE_MASK) != 0))
+    {
+        return 0;
+    }
+    return 1;
+}
+// *****************************************************************************
+
+/* Function:
+    FaultClear()
+
+  Summary:
+    Clears the fault reaction
+
+  Description:
+    A pending restart, a latched fault or a lockout is cleared when the motor
+    is started by the user, and the restart rules apply again in full.
+
+  Precondition:
+    FaultStartAllowed() returns nonzero.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    faultParm.lastFault is kept for the diagnostics.
+ */
+void FaultClear(void)
+{
+    faultParm.state = FAULT_STATE_NONE;
+    faultParm.action = FAULT_ACTION_NONE;
+    RestartClear();
+}
+// *****************************************************************************
+
+/* Function:
+    FaultHardwareTrip()
+
+  Summary:
+    Records a trip of the hardware overcurrent comparator
+
+  Description:
+    The PWM outputs were disabled by the PWM fault input, the trip is handled
+    as a coast reaction so that the restart policy applies to it.
+
+  Precondition:
+    Called from the PWM fault interrupt.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    A trip during the reaction to a software detected fault is ignored,
+    except while braking.
+ */
+void FaultHardwareTrip(void)
+{
+    if ((faultParm.state == FAULT_STATE_NONE) ||
+        (faultParm.state == FAULT_STATE_BRAKE))
+    {
+        faultParm.lastFault = FAULT_HARDWARE;
+        faultParm.lastClass = FAULT_CLASS_HARDWARE;
+        faultParm.reaction = FAULT_REACTION_COAST;
+        faultParm.state = FAULT_STATE_STOP;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    FaultDetectPhaseLoss()
+
+  Summary:
+    Compares the squared phase currents of the window
+
+  Description:
+    The phase loss fault is set if the smallest sum is less than
+    1/FAULT_PHASE_LOSS_RATIO of the largest sum, which is above the sum of
+    FAULT_PHASE_LOSS_CURRENT, for FAULT_PHASE_LOSS_WINDOWS consecutive
+    windows.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+static void FaultDetectPhaseLoss(void)
+{
+    int32_t sumMax = faultParm.sumIa;
+    int32_t sumMin = faultParm.sumIa;
+
+    if (faultParm.sumIb > sumMax)
+    {
+        sumMax = faultParm.sumIb;
+    }
+    if (faultParm.sumIb < sumMin)
+    {
+        sumMin = faultParm.sumIb;
+    }
+    if (faultParm.sumIc > sumMax)
+    {
+        sumMax = faultParm.sumIc;
+    }
+    if (faultParm.sumIc < sumMin)
+    {
+        sumMin = faultParm.sumIc;
+    }
+
+    if ((sumMax > FAULT_PHASE_LOSS_SUM) &&
+        (sumMin < sumMax/FAULT_PHASE_LOSS_RATIO))
+    {
+        faultParm.phaseLossCount++;
+        if (faultParm.phaseLossCount >= FAULT_PHASE_LOSS_WINDOWS)
+        {
+            faultParm.active |= FAULT_PHASE_LOSS;
+        }
+    }
+    else
+    {
+        faultParm.phaseLossCount = 0;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    FaultTrip()
+
+  Summary:
+    Starts the reaction to the faults present
+
+  Description:
+    The reaction of the most severe fault present is selected, the faults
+    are in the order overcurrent, phase loss, overvoltage, stall and
+    undervoltage.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+static void FaultTrip(void)
+{
+    uint16_t fault = faultParm.active;
+
+    if (fault & FAULT_OVERCURRENT)
+    {
+        faultParm.lastFault = FAULT_OVERCURRENT;
+        faultParm.lastClass = FAULT_CLASS_OVERCURRENT;
+        faultParm.reaction = FAULT_OVERCURRENT_REACTION;
+    }
+    else if (fault & FAULT_PHASE_LOSS)
+    {
+        faultParm.lastFault = FAULT_PHASE_LOSS;
+        faultParm.lastClass = FAULT_CLASS_PHASE_LOSS;
+        faultParm.reaction = FAULT_PHASE_LOSS_REACTION;
+    }
+    else if (fault & FAULT_OVERVOLTAGE)
+    {
+        faultParm.lastFault = FAULT_OVERVOLTAGE;
+        faultParm.lastClass = FAULT_CLASS_OVERVOLTAGE;
+        faultParm.reaction = FAULT_OVERVOLTAGE_REACTION;
+    }
+    else if (fault & FAULT_STALL)
+    {
+        faultParm.lastFault = FAULT_STALL;
+        faultParm.lastClass = FAULT_CLASS_STALL;
+        faultParm.reaction = FAULT_STALL_REACTION;
+    }
+    else
+    {
+        faultParm.lastFault = FAULT_UNDERVOLTAGE;
+        faultParm.lastClass = FAULT_CLASS_UNDERVOLTAGE;
+        faultParm.reaction = FAULT_UNDERVOLTAGE_REACTION;
+    }
+
+    if (faultParm.reaction == FAULT_REACTION_BRAKE)
+    {
+        faultParm.delayCount = FAULT_BRAKE_COUNT;
+        faultParm.state = FAULT_STATE_BRAKE;
+    }
+    else
+    {
+        DisablePWMOutputs();
+        faultParm.state = FAULT_STATE_STOP;
+    }
+}
+
+// </editor-fold>
@@ -0,0 +1,193 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file fault.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the software fault detection and of the fault reactions
+ *
+ * Component: FAULT DETECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __FAULT_H
+#define __FAULT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Fault classes */
+#define FAULT_CLASS_OVERCURRENT     0
+#define FAULT_CLASS_STALL           1
+#define FAULT_CLASS_PHASE_LOSS      2
+#define FAULT_CLASS_OVERVOLTAGE     3
+#define FAULT_CLASS_UNDERVOLTAGE    4
+/* Hardware overcurrent comparator trip */
+#define FAULT_CLASS_HARDWARE        5
+#define FAULT_CLASS_COUNT           6
+
+/* Fault codes, one bit per class */
+#define FAULT_OVERCURRENT       (1 << FAULT_CLASS_OVERCURRENT)
+#define FAULT_STALL             (1 << FAULT_CLASS_STALL)
+#define FAULT_PHASE_LOSS        (1 << FAULT_CLASS_PHASE_LOSS)
+#define FAULT_OVERVOLTAGE       (1 << FAULT_CLASS_OVERVOLTAGE)
+#define FAULT_UNDERVOLTAGE      (1 << FAULT_CLASS_UNDERVOLTAGE)
+#define FAULT_HARDWARE          (1 << FAULT_CLASS_HARDWARE)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Fault reaction data type
+
+  Description:
+    Reaction of the drive to a detected fault.
+ */
+typedef enum
+{
+    /* PWM outputs off */
+    FAULT_REACTION_COAST = 0,
+    /* Low side switches on for FAULT_BRAKE_TIME_SEC, then as coast */
+    FAULT_REACTION_BRAKE = 1
+} FAULT_REACTION_T;
+
+/* Fault state data type
+
+  Description:
+    Progress of the reaction to the last fault.
+ */
+typedef enum
+{
+    /* No fault reaction in progress */
+    FAULT_STATE_NONE = 0,
+    /* Braking on the low side switches */
+    FAULT_STATE_BRAKE = 1,
+    /* Motor stopped, waiting for the reinitialization */
+    FAULT_STATE_STOP = 2,
+    /* Motor stopped, waiting to be restarted */
+    FAULT_STATE_WAIT = 3,
+    /* Motor stopped until it is started again */
+    FAULT_STATE_LATCHED = 4
+} FAULT_STATE_T;
+
+/* Fault action data type
+
+  Description:
+    Request from the fault reaction to the main loop.
+ */
+typedef enum
+{
+    FAULT_ACTION_NONE = 0,
+    /* Reinitialize the control after the motor was stopped */
+    FAULT_ACTION_RESET = 1,
+    /* Reinitialize the control and start the motor */
+    FAULT_ACTION_RESTART = 2
+} FAULT_ACTION_T;
+
+/* Fault Detection Parameter data type
+
+  Description:
+    This structure will host parameters related to the detection of
+    overcurrent, stall, phase loss and DC bus over and under voltage, and
+    to the reaction to the detected faults.
+ */
+typedef struct
+{
+    /* Faults present, FAULT_xxx bits */
+    uint16_t active;
+    /* Last fault that stopped the motor */
+    uint16_t lastFault;
+    /* Class of the last fault */
+    uint16_t lastClass;
+    /* Reaction to the last fault */
+    FAULT_REACTION_T reaction;
+    /* Progress of the reaction */
+    FAULT_STATE_T state;
+    /* Request to the main loop */
+    volatile FAULT_ACTION_T action;
+    /* Control cycles left in the brake or restart delay */
+    uint32_t delayCount;
+    /* Consecutive control cycles above the overcurrent threshold */
+    uint16_t overcurrentCount;
+    /* Stall counter, counts up while stalled and down otherwise */
+    uint16_t stallCount;
+    /* Speed calculated from the BEMF magnitude */
+    int16_t qVelBemf;
+    /* Sums of the squared phase currents over the window */
+    int32_t sumIa;
+    int32_t sumIb;
+    int32_t sumIc;
+    /* Control cycles in the phase loss window */
+    uint16_t windowCount;
+    /* Consecutive windows with unbalanced phase currents */
+    uint16_t phaseLossCount;
+    /* Consecutive samples beyond the bus voltage limits */
+    uint16_t overvoltageCount;
+    uint16_t undervoltageCount;
+} FAULT_PARM_T;
+
+extern FAULT_PARM_T faultParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitFaultParams(void);
+void FaultReset(void);
+void FaultDetectCurrent(const MC_ABC_T *pIabc, int16_t qVel);
+void FaultDetectStall(int16_t qVel, int16_t qEsd, int16_t qEsq,
+                      uint16_t saturated);
+void FaultDetectVoltage(int16_t qVdc);
+uint16_t FaultStepIsr(uint16_t running);
+void FaultHardwareTrip(void);
+FAULT_ACTION_T FaultStepMain(void);
+uint16_t FaultStartAllowed(void);
+void FaultClear(void);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAULT_H */
@@ -118,24 +118,24 @@ void InitFWParams(void)
 
 
     /* Initialize inverse Kfi curve values */
-    fdWeakParm.qInvKFiCurve[0] = INVKFI_SPEED0;
-    fdWeakParm.qInvKFiCurve[1] = INVKFI_SPEED1;
-    fdWeakParm.qInvKFiCurve[2] = INVKFI_SPEED2;
-    fdWeakParm.qInvKFiCurve[3] = INVKFI_SPEED3;
-    fdWeakParm.qInvKFiCurve[4] = INVKFI_SPEED4;
-    fdWeakParm.qInvKFiCurve[5] = INVKFI_SPEED5;
-    fdWeakParm.qInvKFiCurve[6] = INVKFI_SPEED6;
-    fdWeakParm.qInvKFiCurve[7] = INVKFI_SPEED7;
-    fdWeakParm.qInvKFiCurve[8] = INVKFI_SPEED8;
-    fdWeakParm.qInvKFiCurve[9] = INVKFI_SPEED9;
-    fdWeakParm.qInvKFiCurve[10] = INVKFI_SPEED10;
-    fdWeakParm.qInvKFiCurve[11] = INVKFI_SPEED11;
-    fdWeakParm.qInvKFiCurve[12] = INVKFI_SPEED12;
-    fdWeakParm.qInvKFiCurve[13] = INVKFI_SPEED13;
-    fdWeakParm.qInvKFiCurve[14] = INVKFI_SPEED14;
-    fdWeakParm.qInvKFiCurve[15] = INVKFI_SPEED15;
-    fdWeakParm.qInvKFiCurve[16] = INVKFI_SPEED16;
-    fdWeakParm.qInvKFiCurve[17] = INVKFI_SPEED17;
+    fdWeakParm.qInvKFiCurve[0] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED0);
+    fdWeakParm.qInvKFiCurve[1] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED1);
+    fdWeakParm.qInvKFiCurve[2] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED2);
+    fdWeakParm.qInvKFiCurve[3] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED3);
+    fdWeakParm.qInvKFiCurve[4] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED4);
+    fdWeakParm.qInvKFiCurve[5] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED5);
+    fdWeakParm.qInvKFiCurve[6] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED6);
+    fdWeakParm.qInvKFiCurve[7] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED7);
+    fdWeakParm.qInvKFiCurve[8] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED8);
+    fdWeakParm.qInvKFiCurve[9] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED9);
+    fdWeakParm.qInvKFiCurve[10] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED10);
+    fdWeakParm.qInvKFiCurve[11] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED11);
+    fdWeakParm.qInvKFiCurve[12] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED12);
+    fdWeakParm.qInvKFiCurve[13] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED13);
+    fdWeakParm.qInvKFiCurve[14] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED14);
+    fdWeakParm.qInvKFiCurve[15] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED15);
+    fdWeakParm.qInvKFiCurve[16] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED16);
+    fdWeakParm.qInvKFiCurve[17] = NORM_VOLTAGE_INV_SCALE(INVKFI_SPEED17);
 
     /* Initialize Ls variation curve */
     fdWeakParm.qLsCurve[0] = LS_OVER2LS0_SPEED0;
@@ -0,0 +1,183 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file flystart.c
+ *
+ * @brief This module implements the flying start (catch spin) detection of a
+ * rotor that is already spinning when the motor is started.
+ *
+ * Component: FLYING START
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "flystart.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+FLYSTART_PARM_T flyStartParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitFlyingStartParams()
+
+  Summary:
+    Initializes flying start parameters
+
+  Description:
+    This routine initializes flying start structure variables and arms the
+    catch sequence
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitFlyingStartParams(void)
+{
+    flyStartParm.counter = 0;
+    flyStartParm.catchTime = FLYING_START_TIME;
+    flyStartParm.qMinCatchSpeed = FLYING_START_MIN_SPEED_ELECTR;
+    flyStartParm.qCatchSpeed = 0;
+    flyStartParm.state = FLYSTART_CATCHING;
+}
+// *****************************************************************************
+
+/* Function:
+    FlyingStartDetect()
+
+  Summary:
+    Decides how the motor is started after the catch sequence
+
+  Description:
+    While the currents are regulated to zero, the voltage applied by the
+    current controllers equals the BEMF of the spinning rotor and the PLL
+    estimator locks to it. Once the catch time has elapsed, the estimated
+    speed is compared against the minimum catch speed to select between
+    closed loop start (forward or reverse) and the open loop start up.
+
+  Precondition:
+    Must be called once every control cycle during zero current control.
+
+  Parameters:
+    qVelEstim - estimated electrical speed
+
+  Returns:
+    State of the catch sequence.
+
+  Remarks:
+    None.
+ */
+FLYSTART_STATE FlyingStartDetect(int16_t qVelEstim)
+{
+    if (flyStartParm.state == FLYSTART_CATCHING)
+    {
+        if (flyStartParm.counter < flyStartParm.catchTime)
+        {
+            flyStartParm.counter++;
+        }
+        else
+        {
+            flyStartParm.qCatchSpeed = qVelEstim;
+
+            if (_Q15abs(qVelEstim) < flyStartParm.qMinCatchSpeed)
+            {
+                flyStartParm.state = FLYSTART_STANDSTILL;
+            }
+            else if (qVelEstim > 0)
+            {
+                flyStartParm.state = FLYSTART_FORWARD;
+            }
+            else
+            {
+                flyStartParm.state = FLYSTART_REVERSE;
+            }
+        }
+    }
+    return flyStartParm.state;
+}
+// *****************************************************************************
+
+/* Function:
+    FlyingStartCoast()
+
+  Summary:
+    Arms the catch sequence after a coast down
+
+  Description:
+    This routine restarts the catch sequence with FLYING_START_COAST_TIME of
+    zero current control, so that a rotor decelerated to the minimum catch
+    speed coasts further before its speed is classified again.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Below the minimum catch speed the estimator is not valid, the rotor is
+    not braked in closed loop down to standstill.
+ */
+void FlyingStartCoast(void)
+{
+    flyStartParm.counter = 0;
+    flyStartParm.catchTime = FLYING_START_COAST_TIME;
+    flyStartParm.state = FLYSTART_CATCHING;
+}
+
+// </editor-fold>
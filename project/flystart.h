@@ -0,0 +1,106 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file flystart.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the flying start (catch spin) module
+ *
+ * Component: FLYING START
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __FLYSTART_H
+#define __FLYSTART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Flying start state data type
+
+  Description:
+    This enumeration lists the result of the rotor catch sequence.
+ */
+typedef enum tagFLYSTART_STATE
+{
+    FLYSTART_CATCHING = 0,      /* zero current control, estimator locking */
+    FLYSTART_STANDSTILL = 1,    /* rotor too slow, use open loop start up */
+    FLYSTART_FORWARD = 2,       /* rotor spinning forward, enter closed loop */
+    FLYSTART_REVERSE = 3        /* rotor spinning in reverse, decelerate */
+} FLYSTART_STATE;
+
+/* Flying start Parameter data type
+
+  Description:
+    This structure will host parameters related to flying start function.
+ */
+typedef struct
+{
+    /* Counter of ADC ISR cycles spent in zero current control */
+    uint16_t counter;
+    /* Duration of the zero current control in ADC ISR cycles */
+    uint16_t catchTime;
+    /* Minimum absolute electrical speed caught in closed loop */
+    int16_t qMinCatchSpeed;
+    /* Estimated speed at the end of the catch sequence */
+    int16_t qCatchSpeed;
+    /* Result of the catch sequence */
+    FLYSTART_STATE state;
+} FLYSTART_PARM_T;
+
+extern FLYSTART_PARM_T flyStartParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitFlyingStartParams(void);
+FLYSTART_STATE FlyingStartDetect(int16_t qVelEstim);
+void FlyingStartCoast(void);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLYSTART_H */
@@ -52,9 +52,28 @@
 #include <stdint.h>
 
 #include "adc.h"
+#include "pwm.h"
 
 // </editor-fold>
 
+#ifdef ADC_OVERSAMPLING
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Largest number of ready checks of WaitADCOversampling(), the second 
+   conversion ends ADC_OVERSAMPLING_SPACING_MICROSEC plus one conversion 
+   after the interrupt trigger, a check takes at least 8 instruction 
+   cycles */
+#define ADC_OVERSAMPLING_WAIT_MAX   (uint16_t)(( \
+                                    ADC_OVERSAMPLING_SPACING_MICROSEC + \
+                                    1.0)*FCY_MHZ/8)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+uint16_t adcOversamplingTimeouts = 0;
+
+// </editor-fold>
+#endif
+
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
 void InitializeADCs(void);
@@ -252,6 +271,36 @@ void InitializeADCs (void)
     ADEISTATL = 0;
     ADEISTATH = 0;
  
+#ifdef ADC_OVERSAMPLING
+    /* ADC digital filter 0 accumulates the Ia conversions */
+    ADFL0CON = 0;
+    /* Filter Mode bits
+       00 = Oversampling mode */
+    ADFL0CONbits.MODE = 0;
+    /* Oversampling Filter Ratio bits, 12-bit conversions
+       100 = 2x (13-bit result) */
+    ADFL0CONbits.OVRSAM = 4;
+    /* Filter Interrupt Enable bit
+       0 = Filter interrupt is disabled, the ISR polls the RDY bit */
+    ADFL0CONbits.IE = 0;
+    /* Filter Input Select bits
+       00001 = AN1 */
+    ADFL0CONbits.FLCHSEL = 1;
+    /* Filter Enable bit
+       1 = Filter is enabled */
+    ADFL0CONbits.FLEN = 1;
+    
+    /* ADC digital filter 1 accumulates the Ib conversions */
+    ADFL1CON = 0;
+    ADFL1CONbits.MODE = 0;
+    ADFL1CONbits.OVRSAM = 4;
+    ADFL1CONbits.IE = 0;
+    /* Filter Input Select bits
+       00100 = AN4 */
+    ADFL1CONbits.FLCHSEL = 4;
+    ADFL1CONbits.FLEN = 1;
+#endif
+    
     ADCON5H = 0;
     /* Shared ADC Core Ready Common Interrupt Enable bit
        0 = Common interrupt is disabled for an ADC core ready event*/
@@ -346,6 +395,11 @@ void InitializeADCs (void)
 #ifdef SINGLE_SHUNT
     /* Trigger Source for Analog Input #0  = 0b0101 for Ibus*/
     ADTRIG0Lbits.TRGSRC0 = 0x5;
+#elif defined(ADC_OVERSAMPLING)
+      /* Trigger Source for Analog Input #1  = 0b0101 for Ia */
+    ADTRIG0Lbits.TRGSRC1 = 0x5;
+    /* Trigger Source for Analog Input #4  = 0b0101 for Ib */
+    ADTRIG1Lbits.TRGSRC4 = 0x5;  
 #else
       /* Trigger Source for Analog Input #1  = 0b0100 for Ia */
     ADTRIG0Lbits.TRGSRC1 = 0x4;
@@ -360,5 +414,51 @@ void InitializeADCs (void)
     ADTRIG4Hbits.TRGSRC18 = 0x4;
 
 }
+#ifdef ADC_OVERSAMPLING
+// *****************************************************************************
+/* Function:
+    void WaitADCOversampling (void)
+
+  Summary:
+    Routine to wait for the oversampled phase currents
+
+  Description:
+    Checks the RDY bits of the ADC digital filters 0 and 1 until both
+    results of the PWM period are available, at most
+    ADC_OVERSAMPLING_WAIT_MAX times.
+
+  Precondition:
+    InitializeADCs() is called before.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called in the control ISR, the wait is bounded to about 
+    ADC_OVERSAMPLING_SPACING_MICROSEC + 1 micro seconds. When a result is 
+    not ready in time the previous result of the filter is used and 
+    adcOversamplingTimeouts is incremented.
+ */
+void WaitADCOversampling (void)
+{
+    uint16_t count = ADC_OVERSAMPLING_WAIT_MAX;
+
+    while ((ADFL0CONbits.RDY == 0) || (ADFL1CONbits.RDY == 0))
+    {
+        if (count == 0)
+        {
+            if (adcOversamplingTimeouts < UINT16_MAX)
+            {
+                adcOversamplingTimeouts++;
+            }
+            break;
+        }
+        count--;
+    }
+}
+#endif
 
 // </editor-fold>
@@ -63,8 +63,24 @@
         
 // <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
 // ADC MODULE Related Definitions
+#ifdef ADC_OVERSAMPLING   /* Phase currents from the ADC digital filters */
+/* The digital filter result is the unsigned integer sum of the two 12-bit 
+   conversions, 0 to 8190, the FORM and SIGNx settings do not apply to it. 
+   ADCBUF1 and ADCBUF4 are signed fractional, (conversion - 2048) << 4, the 
+   sum is converted to the same scale with (sum - 2*2048) << 3, so that the 
+   current gain and the offsets are unchanged */
+#define ADC_OVERSAMPLING_MID_SCALE  (int16_t)4096
+#define ADC_OVERSAMPLING_SHIFT      3
+#define ADC_OVERSAMPLING_SIGNED(sum) \
+                (int16_t)(((int16_t)(sum) - ADC_OVERSAMPLING_MID_SCALE) << \
+                          ADC_OVERSAMPLING_SHIFT)
+#define ADCBUF_INV_A_IPHASE1    -ADC_OVERSAMPLING_SIGNED(ADFL0DAT)
+#define ADCBUF_INV_A_IPHASE2    -ADC_OVERSAMPLING_SIGNED(ADFL1DAT)
+#else
 #define ADCBUF_INV_A_IPHASE1    -ADCBUF1
 #define ADCBUF_INV_A_IPHASE2    -ADCBUF4
+#define WaitADCOversampling()
+#endif
 #define ADCBUF_INV_A_IBUS       ADCBUF0
         
 #define ADCBUF_SPEED_REF_A      ADCBUF17
@@ -87,8 +103,20 @@
 
 // </editor-fold>
 
+// <editor-fold defaultstate="expanded" desc="VARIABLES">
+#ifdef ADC_OVERSAMPLING
+/* Number of oversampled results not ready within ADC_OVERSAMPLING_WAIT_MAX
+   checks, saturates at UINT16_MAX */
+extern uint16_t adcOversamplingTimeouts;
+#endif
+
+// </editor-fold>
+
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
 void InitializeADCs(void);
+#ifdef ADC_OVERSAMPLING
+void WaitADCOversampling(void);
+#endif
 
 // </editor-fold>
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -191,6 +191,10 @@ void InitPeripherals(void)
     /*400ms POR delay for IBUS_EXT signal coming from MCP651S in Dev Board*/
     __delay_ms(400);
     InitPWMGenerators();
+#ifdef ISR_CYCLE_MEASUREMENT
+    /* Instruction cycle counter for the ISR execution time measurement */
+    TIMER1_Initialize();
+#endif
     
     /* Make sure ADC does not generate interrupt while initializing parameters*/
     DisableADCInterrupt();
@@ -253,6 +257,19 @@ void EnablePWMOutputs(void)
     PG1IOCONLbits.OVRENL = 0;     
 }
 
+/**
+ * Check if the PWM channels are driven by the PWM generators.
+ * @return true if the Override is removed, false if the outputs are low.
+ * @example
+ * <code>
+ * enabled = IsEnabled_PWMOutputs();
+ * </code>
+ */
+bool IsEnabled_PWMOutputs(void)
+{
+    return (PG1IOCONLbits.OVRENL == 0);
+}
+
 void ClearPWMPCIFault(void)
 {
     
@@ -312,39 +329,6 @@ void pwmDutyCycleLimitCheck (MC_DUTYCYCLEOUT_T *pPwmDutycycle,uint16_t min,uint1
     }
 }
 
-/**
-* <B> Function: void CompensateDCBusVoltage(MC_ABC_T *,MCAPP_MEASURE_T *)  </B>
-*
-* @brief Computes the reciprocal of the DC bus voltage.
-*
-* @param DC bus voltage
-* @return none.
-* @example
-* <CODE> CompensateDCBusVoltage(&vabc,&measureInputs); </CODE>
-*
-*/
-void CompensateDCBusVoltage(MC_ABC_T *pvabc, MCAPP_MEASURE_T *pmeasureInputs)
-{
-    int16_t rvdc = 0;
-    
-    /* Calculating the reciprocal of DC Bus voltage*/
-    if (pmeasureInputs->dcBusVoltage <= MC_RVDC_MIN_VDC)
-    {
-        rvdc =  MC_RVDC_MIN;
-    }
-    else
-    {
-        rvdc =  __builtin_divf(MC_RVDC_MIN_VDC, pmeasureInputs->dcBusVoltage);
-    }
-    
-    /*DC Bus Voltage Compensation*/
-    pvabc->a = (int16_t)(__builtin_mulss(pvabc->a, rvdc)>> MC_RVDC_Q); 
-                                                                
-    pvabc->b = (int16_t)(__builtin_mulss(pvabc->b, rvdc)>> MC_RVDC_Q); 
-                                                                
-    pvabc->c = (int16_t)(__builtin_mulss(pvabc->c, rvdc)>> MC_RVDC_Q); 
-                                                                
-}
 /**
 * <B> Function: void SaturateAndScalePOTvalue(MC_ABC_T *,MCAPP_MEASURE_T *)  </B>
 *
@@ -62,6 +62,7 @@
 #include "cmp.h"
 #include "delay.h"
 #include "measure.h"
+#include "timer1.h"
 
 // </editor-fold>
 #ifdef __cplusplus  // Provide C++ Compatability
@@ -104,14 +105,6 @@ typedef struct
     PWM ISR cycles (i.e. BOARD_SERVICE_TICK_COUNT = 1 milli Second / PWM period)*/
 #define BOARD_SERVICE_TICK_COUNT   20
 
-/*Parameters for DC Bus compensation*/
-/* binary point for reciprocal voltages */
-#define MC_RVDC_Q                           12
-/* minimum DC link voltage for which we calculate reciprocals */
-#define MC_RVDC_MIN_VDC                     4096    
-/* reciprocal of minimum DC bus voltage */
-#define MC_RVDC_MIN                         32767 
-
 /* definitions to saturate the Potentiometer to get the full scale, 
  * POT will be saturated at 2.2V*/
 /* POT counts : 3.3V = 2^15 = 32767 counts, hence 2.2V = 21845 */
@@ -121,6 +114,7 @@ typedef struct
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 extern void DisablePWMOutputs(void);
 extern void EnablePWMOutputs(void);
+extern bool IsEnabled_PWMOutputs(void);
 extern void ClearPWMPCIFault(void);
 extern void BoardServiceInit(void);
 extern void BoardServiceStepIsr(void);
@@ -131,7 +125,6 @@ extern void InitPeripherals(void);
 extern void PWMDutyCycleSetDualEdge(MC_DUTYCYCLEOUT_T *,MC_DUTYCYCLEOUT_T *);
 extern void PWMDutyCycleSet(MC_DUTYCYCLEOUT_T *);
 extern void pwmDutyCycleLimitCheck(MC_DUTYCYCLEOUT_T *,uint16_t,uint16_t);
-extern void CompensateDCBusVoltage(MC_ABC_T *, MCAPP_MEASURE_T *);
 extern void SaturateAndScalePOTvalue(MCAPP_MEASURE_T *);
 
 // </editor-fold>
@@ -0,0 +1,326 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file filter.c
+ *
+ * @brief This module has filters for the conditioning of slowly varying
+ *        measured signals.
+ *
+ * Component: FILTER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+
+#include "filter.h"
+#include "general.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+/**
+* <B> Function: MCAPP_FilterSaturate(int32_t)  </B>
+*
+* @brief Function to limit a value to the Q15 range.
+*
+* @param Value.
+* @return Value limited to the Q15 range.
+* @example
+* <CODE> output = MCAPP_FilterSaturate(stateVar >> 15); </CODE>
+*
+*/
+inline static int16_t MCAPP_FilterSaturate(int32_t value)
+{
+    if (value > INT16_MAX)
+    {
+        value = INT16_MAX;
+    }
+    else if (value < -INT16_MAX)
+    {
+        value = -INT16_MAX;
+    }
+    return (int16_t)value;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+/**
+* <B> Function: MCAPP_FilterAvgInit(MCAPP_FILTER_AVG_T *,int16_t *,uint16_t,
+* int16_t)  </B>
+*
+* @brief Function to initialize a sliding window moving average.
+*        The window is filled with the initial output, so that
+*        MCAPP_FilterAvg() has the same cost from the first sample on.
+*
+* @param Pointer to the filter data.
+* @param Pointer to the ring buffer of 2^shift samples.
+* @param Window length exponent, limited to MCAPP_FILTER_AVG_SHIFT_MAX.
+* @param Initial output.
+* @return none.
+* @example
+* <CODE> MCAPP_FilterAvgInit(&filter,buffer,8,0); </CODE>
+*
+*/
+void MCAPP_FilterAvgInit(MCAPP_FILTER_AVG_T *pFilter,int16_t *pBuffer,
+                         uint16_t shift,int16_t initial)
+{
+    uint16_t i;
+
+    if (shift > MCAPP_FILTER_AVG_SHIFT_MAX)
+    {
+        shift = MCAPP_FILTER_AVG_SHIFT_MAX;
+    }
+    pFilter->pBuffer = pBuffer;
+    pFilter->shift = shift;
+    pFilter->mask = (uint16_t)((1UL << shift) - 1);
+    for (i = 0; i <= pFilter->mask; i++)
+    {
+        pFilter->pBuffer[i] = initial;
+    }
+    pFilter->index = 0;
+    pFilter->sum = (int32_t)initial << shift;
+    pFilter->output = initial;
+}
+
+/**
+* <B> Function: MCAPP_FilterAvg(MCAPP_FILTER_AVG_T *,int16_t)  </B>
+*
+* @brief Function implementing a sliding window moving average.
+*        The oldest sample in the window is replaced by the new sample and
+*        the sum is corrected by their difference, so the mean value is
+*        updated every sample at a constant cost independent of the window
+*        length.
+*
+* @param Pointer to the filter data.
+* @param New sample.
+* @return Mean value of the last 2^shift samples.
+* @example
+* <CODE> average = MCAPP_FilterAvg(&filter,input); </CODE>
+*
+*/
+int16_t MCAPP_FilterAvg(MCAPP_FILTER_AVG_T *pFilter,int16_t input)
+{
+    pFilter->sum += (int32_t)input - pFilter->pBuffer[pFilter->index];
+    pFilter->pBuffer[pFilter->index] = input;
+    pFilter->index = (pFilter->index + 1) & pFilter->mask;
+    pFilter->output = (int16_t)(pFilter->sum >> pFilter->shift);
+
+    return pFilter->output;
+}
+
+/**
+* <B> Function: MCAPP_FilterLPFInit(MCAPP_FILTER_LPF_T *,int16_t,int16_t)
+* </B>
+*
+* @brief Function to initialize a first order low pass filter.
+*
+* @param Pointer to the filter data.
+* @param Filter constant, 2*pi*fc/fs in Q15.
+* @param Initial output.
+* @return none.
+* @example
+* <CODE> MCAPP_FilterLPFInit(&filter,Q15(0.001),0); </CODE>
+*
+*/
+void MCAPP_FilterLPFInit(MCAPP_FILTER_LPF_T *pFilter,int16_t kFilter,
+                         int16_t initial)
+{
+    pFilter->kFilter = kFilter;
+    pFilter->output = initial;
+    pFilter->stateVar = (int32_t)initial << 15;
+}
+
+/**
+* <B> Function: MCAPP_FilterLPF(MCAPP_FILTER_LPF_T *,int16_t)  </B>
+*
+* @brief Function implementing a first order low pass filter,
+*        output = output + kFilter*(input - output).
+*        The difference is limited to the Q15 range.
+*
+* @param Pointer to the filter data.
+* @param New sample.
+* @return Filter output.
+* @example
+* <CODE> output = MCAPP_FilterLPF(&filter,input); </CODE>
+*
+*/
+int16_t MCAPP_FilterLPF(MCAPP_FILTER_LPF_T *pFilter,int16_t input)
+{
+    pFilter->stateVar += __builtin_mulss(
+                    MCAPP_FilterSaturate((int32_t)input - pFilter->output),
+                    pFilter->kFilter);
+    pFilter->output = (int16_t)(pFilter->stateVar >> 15);
+
+    return pFilter->output;
+}
+
+/**
+* <B> Function: MCAPP_FilterLPF2Init(MCAPP_FILTER_LPF2_T *,int16_t,int16_t,
+* int16_t)  </B>
+*
+* @brief Function to initialize a second order low pass filter.
+*
+* @param Pointer to the filter data.
+* @param Filter constant, 2*sin(pi*fc/fs) in Q15.
+* @param Damping 1/Q in Q14.
+* @param Initial output.
+* @return none.
+* @example
+* <CODE> MCAPP_FilterLPF2Init(&filter,Q15(0.003),23170,0); </CODE>
+*
+*/
+void MCAPP_FilterLPF2Init(MCAPP_FILTER_LPF2_T *pFilter,int16_t kFilter,
+                          int16_t damping,int16_t initial)
+{
+    pFilter->kFilter = kFilter;
+    pFilter->damping = damping;
+    pFilter->band = 0;
+    pFilter->bandStateVar = 0;
+    pFilter->output = initial;
+    pFilter->stateVar = (int32_t)initial << 15;
+}
+
+/**
+* <B> Function: MCAPP_FilterLPF2(MCAPP_FILTER_LPF2_T *,int16_t)  </B>
+*
+* @brief Function implementing a second order low pass filter in state
+*        variable form, low = low + k*band,
+*        band = band + k*(input - low - damping*band).
+*        The filter constant is proportional to the cut off frequency and
+*        keeps its resolution in Q15 for cut off frequencies far below the
+*        sampling frequency.
+*
+* @param Pointer to the filter data.
+* @param New sample.
+* @return Filter output.
+* @example
+* <CODE> output = MCAPP_FilterLPF2(&filter,input); </CODE>
+*
+*/
+int16_t MCAPP_FilterLPF2(MCAPP_FILTER_LPF2_T *pFilter,int16_t input)
+{
+    int32_t high;
+
+    pFilter->stateVar += __builtin_mulss(pFilter->kFilter, pFilter->band);
+    pFilter->output = MCAPP_FilterSaturate(pFilter->stateVar >> 15);
+
+    high = (int32_t)input - pFilter->output -
+            (__builtin_mulss(pFilter->damping, pFilter->band) >> 14);
+    pFilter->bandStateVar += __builtin_mulss(pFilter->kFilter,
+                                             MCAPP_FilterSaturate(high));
+    pFilter->band = MCAPP_FilterSaturate(pFilter->bandStateVar >> 15);
+
+    return pFilter->output;
+}
+
+/**
+* <B> Function: MCAPP_FilterMedianInit(MCAPP_FILTER_MEDIAN_T *)  </B>
+*
+* @brief Function to initialize a median of three filter.
+*        The previous samples are set to the first sample passed to
+*        MCAPP_FilterMedian().
+*
+* @param Pointer to the filter data.
+* @return none.
+* @example
+* <CODE> MCAPP_FilterMedianInit(&filter); </CODE>
+*
+*/
+void MCAPP_FilterMedianInit(MCAPP_FILTER_MEDIAN_T *pFilter)
+{
+    pFilter->previous1 = 0;
+    pFilter->previous2 = 0;
+    pFilter->output = 0;
+    pFilter->status = 0;
+}
+
+/**
+* <B> Function: MCAPP_FilterMedian(MCAPP_FILTER_MEDIAN_T *,int16_t)  </B>
+*
+* @brief Function implementing a median of three filter, a single sample
+*        spike is removed while steps pass with one sample delay.
+*
+* @param Pointer to the filter data.
+* @param New sample.
+* @return Median of the last three samples.
+* @example
+* <CODE> output = MCAPP_FilterMedian(&filter,input); </CODE>
+*
+*/
+int16_t MCAPP_FilterMedian(MCAPP_FILTER_MEDIAN_T *pFilter,int16_t input)
+{
+    int16_t a = pFilter->previous2;
+    int16_t b = pFilter->previous1;
+    int16_t temp;
+
+    if (pFilter->status == 0)
+    {
+        a = input;
+        b = input;
+        pFilter->previous1 = input;
+        pFilter->status = 1;
+    }
+    if (a > b)
+    {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+    /* a <= b, the median is input limited to [a, b] */
+    if (input < a)
+    {
+        pFilter->output = a;
+    }
+    else if (input > b)
+    {
+        pFilter->output = b;
+    }
+    else
+    {
+        pFilter->output = input;
+    }
+    pFilter->previous2 = pFilter->previous1;
+    pFilter->previous1 = input;
+
+    return pFilter->output;
+}
+
+// </editor-fold>
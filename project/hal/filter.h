@@ -0,0 +1,130 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file filter.h
+ *
+ * @brief This module has filters for the conditioning of slowly varying
+ *        measured signals.
+ *
+ * Component: FILTER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __FILTER_H
+#define __FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="DEFINITIONS ">
+
+/* Largest window length exponent of the moving average, the sum of 2^15 Q15
+   samples still fits in 32 bits */
+#define MCAPP_FILTER_AVG_SHIFT_MAX  15
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
+
+/* Sliding window moving average, the ring buffer of 2^shift samples is
+   provided by the user */
+typedef struct
+{
+    int16_t *pBuffer;   /* Ring buffer of the samples in the window */
+    uint16_t mask;      /* Window length - 1 */
+    uint16_t shift;     /* Window length is 2^shift */
+    uint16_t index;     /* Position of the oldest sample */
+    int32_t sum;        /* Sum of the samples in the window */
+    int16_t output;     /* Mean value of the window */
+} MCAPP_FILTER_AVG_T;
+
+/* First order low pass filter */
+typedef struct
+{
+    int16_t kFilter;    /* Filter constant, 2*pi*fc/fs in Q15 */
+    int32_t stateVar;   /* State variable of the output */
+    int16_t output;     /* Filter output */
+} MCAPP_FILTER_LPF_T;
+
+/* Second order low pass filter in state variable form */
+typedef struct
+{
+    int16_t kFilter;    /* Filter constant, 2*sin(pi*fc/fs) in Q15 */
+    int16_t damping;    /* Damping 1/Q in Q14, 23170 for Butterworth */
+    int16_t band;       /* Band pass output */
+    int32_t bandStateVar;   /* State variable of the band pass output */
+    int32_t stateVar;   /* State variable of the output */
+    int16_t output;     /* Low pass output */
+} MCAPP_FILTER_LPF2_T;
+
+/* Median of the last three samples */
+typedef struct
+{
+    int16_t previous1;  /* Previous sample */
+    int16_t previous2;  /* Sample before the previous sample */
+    int16_t output;     /* Median value */
+    uint16_t status;    /* 0 until the first sample */
+} MCAPP_FILTER_MEDIAN_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_FilterAvgInit(MCAPP_FILTER_AVG_T *,int16_t *,uint16_t ,int16_t );
+int16_t MCAPP_FilterAvg(MCAPP_FILTER_AVG_T *,int16_t );
+void MCAPP_FilterLPFInit(MCAPP_FILTER_LPF_T *,int16_t ,int16_t );
+int16_t MCAPP_FilterLPF(MCAPP_FILTER_LPF_T *,int16_t );
+void MCAPP_FilterLPF2Init(MCAPP_FILTER_LPF2_T *,int16_t ,int16_t ,int16_t );
+int16_t MCAPP_FilterLPF2(MCAPP_FILTER_LPF2_T *,int16_t );
+void MCAPP_FilterMedianInit(MCAPP_FILTER_MEDIAN_T *);
+int16_t MCAPP_FilterMedian(MCAPP_FILTER_MEDIAN_T *,int16_t );
+
+// </editor-fold>
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of __FILTER_H */
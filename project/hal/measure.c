@@ -55,6 +55,37 @@
 
 // </editor-fold>
 
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+/**
+* <B> Function: MCAPP_MeasureOffsetError(int16_t,int16_t)  </B>
+*
+* @brief Function to calculate the limited deviation of a sample from the 
+*        offset.
+*
+* @param Current sample.
+* @param Current offset.
+* @return Deviation limited to OFFSET_TRACK_ERROR_MAX.
+* @example
+* <CODE> error = MCAPP_MeasureOffsetError(Ia,offsetIa); </CODE>
+*
+*/
+inline static int32_t MCAPP_MeasureOffsetError(int16_t sample,int16_t offset)
+{
+    int32_t error = (int32_t)sample - offset;
+    
+    if (error > OFFSET_TRACK_ERROR_MAX)
+    {
+        error = OFFSET_TRACK_ERROR_MAX;
+    }
+    else if (error < -OFFSET_TRACK_ERROR_MAX)
+    {
+        error = -OFFSET_TRACK_ERROR_MAX;
+    }
+    return error;
+}
+
+// </editor-fold>
+
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 /**
 * <B> Function: MCAPP_MeasureCurrentInit(MCAPP_MEASURE_CURRENT_T *)  </B>
@@ -74,11 +105,107 @@ void MCAPP_MeasureCurrentInit(MCAPP_MEASURE_T *pMotorInputs)
     
     pCurrent = &pMotorInputs->current;
     
+#ifdef CURRENT_OFFSET_TRACKING
+    /* The tracked offsets are kept between runs */
+    if (pCurrent->status != 0)
+    {
+        return;
+    }
+#endif
     pCurrent->counter = 0;
     pCurrent->sumIa = 0;
     pCurrent->sumIb = 0;
     pCurrent->sumIbus = 0;
     pCurrent->status = 0;
+#ifdef CURRENT_OFFSET_TRACKING
+    pCurrent->coastCounter = 0;
+#endif
+}
+
+/**
+* <B> Function: MCAPP_MeasureCurrentOffsetTrack(MCAPP_MEASURE_T *)  </B>
+*
+* @brief Function to track the current offsets while no current flows.
+*
+* Each sample moves the offsets by the deviation from the offset, limited to
+* OFFSET_TRACK_ERROR_MAX, divided by 2^OFFSET_TRACK_SHIFT. The sums keep the
+* offsets with 16 fractional bits. The first OFFSET_TRACK_SETTLE_COUNT 
+* samples after reset use the fast time constant, then the offsets are valid
+* and are kept as reference for the drift telemetry. After
+* MCAPP_MeasureCurrentOffsetHold() the samples of OFFSET_TRACK_COAST_COUNT
+* calls are skipped, while the rotor may still be coasting.
+*
+* @param Pointer to the data structure containing measured currents.
+* @return none.
+* @example
+* <CODE> MCAPP_MeasureCurrentOffsetTrack(&measureInputs); </CODE>
+*
+*/
+void MCAPP_MeasureCurrentOffsetTrack(MCAPP_MEASURE_T *pMotorInputs)
+{
+    MCAPP_MEASURE_CURRENT_T *pCurrent;
+    int16_t shift;
+    
+    pCurrent = &pMotorInputs->current;
+    
+    if (pCurrent->coastCounter > 0)
+    {
+        pCurrent->coastCounter--;
+        return;
+    }
+    if (pCurrent->status == 0)
+    {
+        shift = OFFSET_TRACK_FAST_SHIFT;
+    }
+    else
+    {
+        shift = OFFSET_TRACK_SHIFT;
+    }
+    
+    pCurrent->sumIa += MCAPP_MeasureOffsetError(pCurrent->Ia,
+                                        pCurrent->offsetIa) << (16 - shift);
+    pCurrent->sumIb += MCAPP_MeasureOffsetError(pCurrent->Ib,
+                                        pCurrent->offsetIb) << (16 - shift);
+    pCurrent->sumIbus += MCAPP_MeasureOffsetError(pCurrent->Ibus,
+                                        pCurrent->offsetIbus) << (16 - shift);
+    pCurrent->offsetIa = (int16_t)(pCurrent->sumIa >> 16);
+    pCurrent->offsetIb = (int16_t)(pCurrent->sumIb >> 16);
+    pCurrent->offsetIbus = (int16_t)(pCurrent->sumIbus >> 16);
+    
+    if (pCurrent->status == 0)
+    {
+        pCurrent->counter++;
+        if (pCurrent->counter >= OFFSET_TRACK_SETTLE_COUNT)
+        {
+            pCurrent->offsetRefIa = pCurrent->offsetIa;
+            pCurrent->offsetRefIb = pCurrent->offsetIb;
+            pCurrent->offsetRefIbus = pCurrent->offsetIbus;
+            pCurrent->counter = 0;
+            pCurrent->status = 1;
+        }
+    }
+    
+    pCurrent->driftIa = pCurrent->offsetIa - pCurrent->offsetRefIa;
+    pCurrent->driftIb = pCurrent->offsetIb - pCurrent->offsetRefIb;
+    pCurrent->driftIbus = pCurrent->offsetIbus - pCurrent->offsetRefIbus;
+}
+
+/**
+* <B> Function: MCAPP_MeasureCurrentOffsetHold(MCAPP_MEASURE_T *)  </B>
+*
+* @brief Function to stop the offset tracking while the PWM outputs are
+*        enabled and for OFFSET_TRACK_COAST_COUNT samples after they are
+*        disabled, until the rotor is at standstill.
+*
+* @param Pointer to the data structure containing measured currents.
+* @return none.
+* @example
+* <CODE> MCAPP_MeasureCurrentOffsetHold(&measureInputs); </CODE>
+*
+*/
+void MCAPP_MeasureCurrentOffsetHold(MCAPP_MEASURE_T *pMotorInputs)
+{
+    pMotorInputs->current.coastCounter = OFFSET_TRACK_COAST_COUNT;
 }
 
 /**
@@ -145,73 +272,113 @@ int16_t MCAPP_MeasureCurrentOffsetStatus (MCAPP_MEASURE_T *pMotorInputs)
 }
 
 /**
-* <B> Function: void MC_MovingAvgFilterInit(MC_MOVING_AVG_T *)              </B>
+* <B> Function: MCAPP_MeasureInit(MCAPP_MEASURE_T *)  </B>
 *
-* @brief Function to reset moving average filter history .
+* @brief Function to initialize the filters of the slowly varying
+*        measurements. The median filters and the bus voltage low pass
+*        filter start from their first sample, the moving averages from
+*        the idle potentiometer and 25 degrees Celsius.
 *
-* @param none.
+* @param Pointer to the data structure containing measured values.
 * @return none.
 * @example
-* <CODE> MC_MovingAvgFilterInit(&filterData); </CODE>
+* <CODE> MCAPP_MeasureInit(&measureInputs); </CODE>
 *
 */
-void MCAPP_MeasureAvgInit(MCAPP_MEASURE_AVG_T *pFilterData,uint16_t scaler)
+void MCAPP_MeasureInit(MCAPP_MEASURE_T *pData)
 {
-    pFilterData->scaler = scaler;
-    pFilterData->maxIndex = (uint16_t)((1 << scaler));
-    pFilterData->index = 0;
-    pFilterData->sum = 0;
-    pFilterData->status = 0;
+#ifdef MEASURE_INPUT_FILTER
+    MCAPP_FilterMedianInit(&pData->potMedian);
+    MCAPP_FilterAvgInit(&pData->potAvg, pData->potBuffer,
+                        POT_AVG_FILTER_SCALE, 0);
+    MCAPP_FilterLPF2Init(&pData->dcBusVoltageFilter, DCBUS_FILTER_KFILTER,
+                         DCBUS_FILTER_DAMPING, 0);
+#endif
+    MCAPP_FilterMedianInit(&pData->dcBusVoltageMedian);
+    MCAPP_FilterMedianInit(&pData->MOSFETTemperatureMedian);
+    MCAPP_FilterAvgInit(&pData->MOSFETTemperature,
+                        pData->MOSFETTemperatureBuffer,
+                        MOSFET_TEMP_AVG_FILTER_SCALE,
+                        MOSFET_TEMP_INITIAL_COUNT);
 }
+
 /**
-* <B> Function: void MC_MovingAvgFilter(MC_MOVING_AVG_T *,int16_t )         </B>
+* <B> Function: MCAPP_MeasurePot(MCAPP_MEASURE_T *,int16_t)  </B>
 *
-* @brief Function implementing moving average filter .
+* @brief Function to filter the potentiometer measurement with spike
+*        rejection and a moving average of 2^POT_AVG_FILTER_SCALE samples,
+*        when MEASURE_INPUT_FILTER is defined.
 *
-* @param none.
+* @param Pointer to the data structure containing measured values.
+* @param Potentiometer sample.
 * @return none.
 * @example
-* <CODE> MC_MovingAvgFilter(&filterData,data );                          </CODE>
+* <CODE> MCAPP_MeasurePot(&measureInputs,sample); </CODE>
 *
 */
-int16_t MCAPP_MeasureAvg(MCAPP_MEASURE_AVG_T *pFilterData)
-{    
-    pFilterData->sum += pFilterData->input;
+void MCAPP_MeasurePot(MCAPP_MEASURE_T *pData, int16_t input)
+{
+#ifdef MEASURE_INPUT_FILTER
+    pData->potValue = MCAPP_FilterAvg(&pData->potAvg,
+                        MCAPP_FilterMedian(&pData->potMedian, input));
+#else
+    pData->potValue = input;
+#endif
+}
 
-    if (pFilterData->index < pFilterData->maxIndex)
-    {
-        pFilterData->index++;
-    }
-    else
+/**
+* <B> Function: MCAPP_MeasureDCBusVoltage(MCAPP_MEASURE_T *,int16_t)  </B>
+*
+* @brief Function to filter the DC bus voltage measurement with spike
+*        rejection and, when MEASURE_INPUT_FILTER is defined, a second
+*        order low pass filter, which attenuates the rectifier ripple.
+*
+* @param Pointer to the data structure containing measured values.
+* @param DC bus voltage sample.
+* @return none.
+* @example
+* <CODE> MCAPP_MeasureDCBusVoltage(&measureInputs,sample); </CODE>
+*
+*/
+void MCAPP_MeasureDCBusVoltage(MCAPP_MEASURE_T *pData, int16_t input)
+{
+#ifdef MEASURE_INPUT_FILTER
+    if (pData->dcBusVoltageMedian.status == 0)
     {
-        pFilterData->avg = pFilterData->sum >> pFilterData->scaler; 
-        pFilterData->sum = 0;
-        pFilterData->index = 0;
-        pFilterData->status = 1;
+        MCAPP_FilterLPF2Init(&pData->dcBusVoltageFilter, DCBUS_FILTER_KFILTER,
+                             DCBUS_FILTER_DAMPING, input);
     }
-    return pFilterData->avg;
+    pData->dcBusVoltage = MCAPP_FilterLPF2(&pData->dcBusVoltageFilter,
+                        MCAPP_FilterMedian(&pData->dcBusVoltageMedian, input));
+#else
+    MCAPP_FilterMedian(&pData->dcBusVoltageMedian, input);
+    pData->dcBusVoltage = input;
+#endif
 }
+
 /**
-* <B> Function: void MC_MovingAvgFilterInit(MC_MOVING_AVG_T *)              </B>
+* <B> Function: MCAPP_MeasureTemperature(MCAPP_MEASURE_T *,int16_t)  </B>
 *
-* @brief Function to reset moving average filter history .
+* @brief Function to filter the MOSFET temperature measurement with spike
+*        rejection and a moving average of 2^MOSFET_TEMP_AVG_FILTER_SCALE
+*        samples, and to convert it into degrees Celsius every sample.
 *
-* @param none.
+* @param Pointer to the data structure containing measured values.
+* @param Temperature sensor sample.
 * @return none.
 * @example
-* <CODE> MC_MovingAvgFilterInit(&filterData); </CODE>
+* <CODE> MCAPP_MeasureTemperature(&measureInputs,sample); </CODE>
 *
 */
 void MCAPP_MeasureTemperature(MCAPP_MEASURE_T *pData, int16_t input)
 {
-    pData->MOSFETTemperature.input = input;
-    pData->MOSFETTemperatureAvg = MCAPP_MeasureAvg(&pData->MOSFETTemperature);
-    if (pData->MOSFETTemperature.status == 1)
-    {
-        pData->MOSFETTemperatureAvg = (int16_t)(__builtin_mulss
-                ((pData->MOSFETTemperatureAvg-OFFSET_COUNT_MOSFET_TEMP) ,
+    int16_t average;
+
+    average = MCAPP_FilterAvg(&pData->MOSFETTemperature,
+                MCAPP_FilterMedian(&pData->MOSFETTemperatureMedian, input));
+    pData->MOSFETTemperatureAvg = (int16_t)(__builtin_mulss
+                ((average-OFFSET_COUNT_MOSFET_TEMP) ,
                 MOSFET_TEMP_COEFF) >> 15);
-    }
 }
 
 // </editor-fold>
\ No newline at end of file
@@ -57,6 +57,8 @@ extern "C" {
 #include <stdint.h>
     
 #include "general.h"
+#include "userparms.h"
+#include "filter.h"
 
 // </editor-fold>
 
@@ -65,9 +67,36 @@ extern "C" {
 #define OFFSET_COUNT_BITS   (int16_t)10
 #define OFFSET_COUNT_MAX    (int16_t)(1 << OFFSET_COUNT_BITS)
     
+/* Background offset tracking: filter time constant of 2^OFFSET_TRACK_SHIFT 
+   samples, 2^OFFSET_TRACK_FAST_SHIFT samples during the first 
+   OFFSET_TRACK_SETTLE_COUNT samples after reset */
+#define OFFSET_TRACK_SHIFT          (int16_t)12
+#define OFFSET_TRACK_FAST_SHIFT     (int16_t)4
+#define OFFSET_TRACK_SETTLE_COUNT   (int16_t)64
+/* Largest sample deviation from the offset taken into account, bounds the 
+   slew rate of the offset */
+#define OFFSET_TRACK_ERROR_MAX      (int16_t)512
+/* Samples after the PWM outputs are disabled until the offsets are tracked,
+   at 20kHz sampling */
+#define OFFSET_TRACK_COAST_COUNT    (uint16_t)(CURRENT_OFFSET_COAST_TIME_SEC* \
+                                               20000.0)
+    
 #define OFFSET_COUNT_MOSFET_TEMP 4964
 #define MOSFET_TEMP_COEFF Q15(0.010071108)    //3.3V/(32767*0.01V)
 #define MOSFET_TEMP_AVG_FILTER_SCALE     8
+/* Initial temperature sample, 25 degrees Celsius */
+#define MOSFET_TEMP_INITIAL_COUNT (int16_t)(OFFSET_COUNT_MOSFET_TEMP + \
+                                    25.0/0.010071108)
+/* Potentiometer moving average of 2^POT_AVG_FILTER_SCALE samples */
+#define POT_AVG_FILTER_SCALE             4
+/* DC bus voltage second order filter, 20Hz cut off at 20kHz sampling */
+#define DCBUS_FILTER_KFILTER    Q15(0.00628)
+#define DCBUS_FILTER_DAMPING    (int16_t)23170
+
+#if (MOSFET_TEMP_AVG_FILTER_SCALE > MCAPP_FILTER_AVG_SHIFT_MAX) || \
+    (POT_AVG_FILTER_SCALE > MCAPP_FILTER_AVG_SHIFT_MAX)
+#error "Moving average window exponents must not exceed MCAPP_FILTER_AVG_SHIFT_MAX"
+#endif
     
 // </editor-fold>
 
@@ -83,26 +112,23 @@ typedef struct
         Ib,             /* B phase Current Feedback */
         Ibus,           /* BUS current Feedback */
         counter,        /* counter */
-        status;         /* flag to indicate offset measurement completion */
+        status,         /* flag to indicate offset measurement completion */
+        driftIa,        /* A phase offset change since the first offset */
+        driftIb,        /* B phase offset change since the first offset */
+        driftIbus,      /* BUS current offset change since the first offset */
+        offsetRefIa,    /* A phase first offset */
+        offsetRefIb,    /* B phase first offset */
+        offsetRefIbus;  /* BUS current first offset */
 
     int32_t
         sumIa,          /* Accumulation of Ia */
         sumIb,          /* Accumulation of Ib */
         sumIbus;        /* Accumulation of Ibus */
 
-} MCAPP_MEASURE_CURRENT_T;
+    uint16_t
+        coastCounter;   /* Samples until the rotor is at standstill */
 
-typedef struct
-{
-    int16_t input;
-    uint16_t index;
-    uint16_t maxIndex;
-    uint16_t scaler;
-    int16_t avg;
-    int32_t sum;
-    uint16_t status;
-    
-}MCAPP_MEASURE_AVG_T;
+} MCAPP_MEASURE_CURRENT_T;
 
 typedef struct
 {
@@ -110,11 +136,30 @@ typedef struct
         potValue;         /* Measure potentiometer */
     int16_t 
         potValueScaled;         /* Measure potentiometer */
+#ifdef MEASURE_INPUT_FILTER
+    MCAPP_FILTER_MEDIAN_T
+        potMedian;              /* Potentiometer spike rejection */
+    MCAPP_FILTER_AVG_T
+        potAvg;                 /* Potentiometer moving average */
+    int16_t
+        potBuffer[1 << POT_AVG_FILTER_SCALE];
+#endif
+    int16_t
+        dcBusVoltage;           /* Filtered DC bus voltage */
+    MCAPP_FILTER_MEDIAN_T
+        dcBusVoltageMedian;     /* DC bus voltage spike rejection */
+#ifdef MEASURE_INPUT_FILTER
+    MCAPP_FILTER_LPF2_T
+        dcBusVoltageFilter;     /* DC bus voltage low pass filter */
+#endif
     int16_t
-        dcBusVoltage;
+        MOSFETTemperatureAvg;   /* MOSFET temperature in degrees Celsius */
+    MCAPP_FILTER_MEDIAN_T
+        MOSFETTemperatureMedian;    /* MOSFET temperature spike rejection */
+    MCAPP_FILTER_AVG_T
+        MOSFETTemperature;      /* MOSFET temperature moving average */
     int16_t
-        MOSFETTemperatureAvg;  
-    MCAPP_MEASURE_AVG_T MOSFETTemperature;
+        MOSFETTemperatureBuffer[1 << MOSFET_TEMP_AVG_FILTER_SCALE];
     MCAPP_MEASURE_CURRENT_T
         current;     /* Current measurement parameters */
             
@@ -127,10 +172,13 @@ typedef struct
 void MCAPP_MeasureCurrentOffset (MCAPP_MEASURE_T *);
 void MCAPP_MeasureCurrentCalibrate (MCAPP_MEASURE_T *);
 void MCAPP_MeasureCurrentInit (MCAPP_MEASURE_T *);
+void MCAPP_MeasureCurrentOffsetTrack (MCAPP_MEASURE_T *);
+void MCAPP_MeasureCurrentOffsetHold (MCAPP_MEASURE_T *);
 int16_t MCAPP_MeasureCurrentOffsetStatus (MCAPP_MEASURE_T *);
+void MCAPP_MeasureInit(MCAPP_MEASURE_T *);
+void MCAPP_MeasurePot(MCAPP_MEASURE_T *,int16_t );
+void MCAPP_MeasureDCBusVoltage(MCAPP_MEASURE_T *,int16_t );
 void MCAPP_MeasureTemperature(MCAPP_MEASURE_T *,int16_t );
-void MCAPP_MeasureAvgInit(MCAPP_MEASURE_AVG_T *,uint16_t );
-int16_t MCAPP_MeasureAvg(MCAPP_MEASURE_AVG_T *);
 
 // </editor-fold>
 
@@ -259,6 +259,11 @@ void MapGPIOHWFunction(void)
     TRISEbits.TRISE13 = 0;           // PIN:64 - RE13
     // LED1 : 
     TRISEbits.TRISE12 = 0;           // PIN:62 - RE12
+#ifdef BRAKE_CHOPPER
+    // Brake chopper :
+    LATEbits.LATE14 = 0;
+    TRISEbits.TRISE14 = 0;           // RE14
+#endif
 
     // Push button Switches
     
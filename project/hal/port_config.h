@@ -78,6 +78,10 @@
 // LED1 : (RE12)
 #define LED1                    LATEbits.LATE12
 
+// Brake chopper gate driver input, not fitted on the development board
+// BRAKE_CHOPPER_OUTPUT : (RE14)
+#define BRAKE_CHOPPER_OUTPUT    LATEbits.LATE14
+
 // </editor-fold>
         
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
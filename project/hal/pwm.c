@@ -521,6 +521,15 @@ void InitPWMGenerator1 (void)
        0 = PG1TRIGB register compare event is enabled as 
            trigger source for ADC Trigger 2 */
     PG1EVTHbits.ADTR2EN2 = 1;
+#elif defined(ADC_OVERSAMPLING)
+        /* ADC Trigger 2 Source is PG1TRIGC Compare Event Enable bit
+       0 = PG1TRIGC register compare event is disabled as 
+           trigger source for ADC Trigger 2 */
+    PG1EVTHbits.ADTR2EN3 = 0;
+    /* ADC Trigger 2 Source is PG1TRIGB Compare Event Enable bit
+       1 = PG1TRIGB register compare event is enabled as 
+           trigger source for ADC Trigger 2 */
+    PG1EVTHbits.ADTR2EN2 = 1;
 #else
         /* ADC Trigger 2 Source is PG1TRIGC Compare Event Enable bit
        0 = PG1TRIGC register compare event is disabled as 
@@ -531,10 +540,17 @@ void InitPWMGenerator1 (void)
            trigger source for ADC Trigger 2 */
     PG1EVTHbits.ADTR2EN2 = 0;
 #endif
+#ifdef ADC_OVERSAMPLING
+    /* ADC Trigger 2 Source is PG1TRIGA Compare Event Enable bit
+       1 = PG1TRIGA register compare event is enabled as 
+           trigger source for ADC Trigger 2 */
+    PG1EVTHbits.ADTR2EN1 = 1;
+#else
     /* ADC Trigger 2 Source is PG1TRIGA Compare Event Enable bit
        0 = PG1TRIGA register compare event is disabled as 
            trigger source for ADC Trigger 2 */
     PG1EVTHbits.ADTR2EN1 = 0;
+#endif
     /* ADC Trigger 1 Offset Selection bits
        00000 = No offset */
     PG1EVTHbits.ADTR1OFS = 0;
@@ -648,7 +664,11 @@ void InitPWMGenerator1 (void)
     /* Initialize PWM GENERATOR 1 TRIGGER A REGISTER */
     PG1TRIGA     = ADC_SAMPLING_POINT;
     /* Initialize PWM GENERATOR 1 TRIGGER B REGISTER */
+#ifdef ADC_OVERSAMPLING
+    PG1TRIGB     = ADC_SAMPLING_POINT + ADC_OVERSAMPLING_SPACING;
+#else
     PG1TRIGB     = 0x0000;
+#endif
     /* Initialize PWM GENERATOR 1 TRIGGER C REGISTER */
     PG1TRIGC     = 0x0000;
     
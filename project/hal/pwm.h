@@ -105,6 +105,9 @@
 
 /* Specify ADC Triggering Point w.r.t PWM Output for sensing Motor Currents */
 #define ADC_SAMPLING_POINT      0x0000
+/* Specify spacing of the oversampled current conversions in micro seconds */
+#define ADC_OVERSAMPLING_SPACING_MICROSEC   0.5
+#define ADC_OVERSAMPLING_SPACING    (uint16_t)(ADC_OVERSAMPLING_SPACING_MICROSEC*FOSC_MHZ)
         
 #define MIN_DUTY            0x0000
 
@@ -0,0 +1,102 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file timer1.c
+ *
+ * @brief This module configures Timer1 as a free running instruction cycle
+ * counter used to measure execution time
+ *
+ * Definitions in this file are for dsPIC33CK256MP508
+ *
+ * Component: TIMER1
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Header Files ">
+
+#include <xc.h>
+#include <stdint.h>
+
+#include "timer1.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+ * Function to configure Timer1 as a free running counter clocked by FCY
+ * @param None.
+ * @return None.
+ * @example
+ * <code>
+ * TIMER1_Initialize();
+ * </code>
+ */
+void TIMER1_Initialize(void)
+{
+    /** Initialize T1CON REGISTER */
+    T1CON = 0;
+    /** Timer1 On bit
+        1 = Starts 16-bit Timer1
+        0 = Stops 16-bit Timer1 */
+    T1CONbits.TON = 0;
+    /** Timer1 Stop in Idle Mode bit
+        0 = Continues module operation in Idle mode */
+    T1CONbits.SIDL = 0;
+    /** Timer1 Clock Source Select bit
+        0 = Internal peripheral clock (FP = FCY) */
+    T1CONbits.TCS = 0;
+    /** Timer1 Input Clock Prescale Select bits
+        0b11 = 1:256,0b10 = 1:64,0b01 = 1:8,0b00 = 1:1 */
+    T1CONbits.TCKPS = 0;
+    /** Timer1 Gated Time Accumulation Enable bit
+        0 = Gated time accumulation is disabled */
+    T1CONbits.TGATE = 0;
+
+    /** Timer1 counts up to full scale and rolls over */
+    TMR1 = 0;
+    PR1 = 0xFFFF;
+
+    /** Timer1 interrupt is not used */
+    _T1IF = 0;
+    _T1IE = 0;
+
+    T1CONbits.TON = 1;
+}
+
+// </editor-fold>
@@ -0,0 +1,349 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file hfi.c
+ *
+ * @brief This module implements the high frequency injection angle estimator
+ * used at low speed and its speed dependent blending with the PLL estimator.
+ *
+ * Component: HFI - ESTIMATOR
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "hfi.h"
+#include "general.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+HFI_PARM_T hfiParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitHFIParams()
+
+  Summary:
+    Initializes high frequency injection estimator parameters
+
+  Description:
+    This routine initializes the high frequency injection estimator
+    structure variables
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitHFIParams(void)
+{
+    hfiParm.qVInject = HFI_VOLTAGE;
+    hfiParm.qKp = HFI_PLL_PTERM;
+    hfiParm.qKi = HFI_PLL_ITERM;
+    hfiParm.qBlendStartSpeed = HFI_BLEND_START_ELECTR;
+    hfiParm.qBlendGain = HFI_BLEND_GAIN;
+    hfiParm.qWeight = 0;
+
+    HFISync(0, 0);
+}
+// *****************************************************************************
+
+/* Function:
+    HFIDemodulate()
+
+  Summary:
+    Separates the injection response from the d-q currents
+
+  Description:
+    The d-axis square wave injection alternates its sign every control cycle,
+    so the current response alternates around the fundamental current.
+    The fundamental current is the average of two consecutive samples and the
+    angle error signal is the change of the q current multiplied by the sign
+    of the voltage that caused it. For an estimated angle lagging the rotor
+    by the error angle, the error signal is proportional to
+    Vinj * Ts * (1/Ld - 1/Lq) * sin(2 * error angle) / 2
+
+  Precondition:
+    The d-q currents must be calculated with the angle used for the injection.
+
+  Parameters:
+    pIdq - pointer to the d-q currents, replaced by the fundamental currents
+
+  Returns:
+    None.
+
+  Remarks:
+    The voltage computed in one control cycle is applied during the next PWM
+    period, so the current difference measured now is the response to the
+    injection computed two control cycles earlier.
+ */
+void HFIDemodulate(MC_DQ_T *pIdq)
+{
+    int16_t qId = pIdq->d;
+    int16_t qIq = pIdq->q;
+    int16_t qDeltaIq = (int16_t)(qIq - hfiParm.qLastIq);
+
+    if (hfiParm.qDemodVdInject > 0)
+    {
+        hfiParm.qError = qDeltaIq;
+    }
+    else if (hfiParm.qDemodVdInject < 0)
+    {
+        hfiParm.qError = -qDeltaIq;
+    }
+    else
+    {
+        hfiParm.qError = 0;
+    }
+
+    if (hfiParm.qDemodVdInject != 0)
+    {
+        pIdq->d = (qId >> 1) + (hfiParm.qLastId >> 1);
+        pIdq->q = (qIq >> 1) + (hfiParm.qLastIq >> 1);
+    }
+
+    hfiParm.qLastId = qId;
+    hfiParm.qLastIq = qIq;
+}
+// *****************************************************************************
+
+/* Function:
+    HFIEstimate()
+
+  Summary:
+    Tracks the rotor angle from the injection response and blends it with the
+    PLL estimator
+
+  Description:
+    A PI tracking loop drives the demodulated error signal to zero, its output
+    is the speed and the integral of the speed is the angle, scaled as in the
+    PLL estimator. The angle and speed used by the control are cross faded
+    from the injection estimate to the PLL estimate between
+    HFI_BLEND_START_RPM and HFI_BLEND_END_RPM, and the injection amplitude is
+    reduced by the same weight. Above the blending range the tracking loop
+    follows the PLL estimator so that the injection resumes from the present
+    angle when the speed decreases.
+
+  Precondition:
+    HFIDemodulate() must be called in the same control cycle.
+
+  Parameters:
+    qRhoPll - angle of the PLL estimator
+    qVelPll - speed of the PLL estimator
+
+  Returns:
+    None.
+
+  Remarks:
+    The rotor polarity is not observable from the injection response, the
+    tracking loop must be seeded with the polarity resolved angle by
+    HFISync().
+ */
+void HFIEstimate(int16_t qRhoPll, int16_t qVelPll)
+{
+    int32_t weight, omega;
+    int16_t qVdInject, tempint;
+
+    /* Weight of the PLL estimator from the blended speed of last cycle */
+    weight = __builtin_mulss((int16_t)(_Q15abs(hfiParm.qVel) -
+                                hfiParm.qBlendStartSpeed), hfiParm.qBlendGain);
+    if (weight < 0)
+    {
+        weight = 0;
+    }
+    else if (weight > Q15(0.9999))
+    {
+        weight = Q15(0.9999);
+    }
+    hfiParm.qWeight = (int16_t)weight;
+
+    if (hfiParm.qWeight < Q15(0.9999))
+    {
+        /* Tracking PLL */
+        hfiParm.qOmegaStateVar += __builtin_mulss(hfiParm.qKi,
+                                                  hfiParm.qError);
+        if (hfiParm.qOmegaStateVar > HFI_PLL_OMEGA_MAX)
+        {
+            hfiParm.qOmegaStateVar = HFI_PLL_OMEGA_MAX;
+        }
+        else if (hfiParm.qOmegaStateVar < -HFI_PLL_OMEGA_MAX)
+        {
+            hfiParm.qOmegaStateVar = -HFI_PLL_OMEGA_MAX;
+        }
+        omega = (hfiParm.qOmegaStateVar +
+                __builtin_mulss(hfiParm.qKp, hfiParm.qError)) >> HFI_PLL_SCALE;
+        if (omega > MAXIMUMSPEED_ELECTR)
+        {
+            omega = MAXIMUMSPEED_ELECTR;
+        }
+        else if (omega < -MAXIMUMSPEED_ELECTR)
+        {
+            omega = -MAXIMUMSPEED_ELECTR;
+        }
+        hfiParm.qOmega = (int16_t)omega;
+
+        hfiParm.qRhoStateVar += __builtin_mulss(hfiParm.qOmega, NORM_DELTAT);
+        hfiParm.qRhoHfi = (int16_t)(hfiParm.qRhoStateVar >> 15);
+
+        tempint = (int16_t)(hfiParm.qOmega - hfiParm.qVelHfi);
+        hfiParm.qVelStateVar += __builtin_mulss(tempint, KFILTER_VELESTIM);
+        hfiParm.qVelHfi = (int16_t)(hfiParm.qVelStateVar >> 15);
+
+        /* Cross fade, the angle difference wraps around the circle */
+        tempint = (int16_t)(qRhoPll - hfiParm.qRhoHfi);
+        hfiParm.qRho = hfiParm.qRhoHfi +
+                (int16_t)(__builtin_mulss(hfiParm.qWeight, tempint) >> 15);
+        hfiParm.qVel = hfiParm.qVelHfi + (int16_t)(__builtin_mulss(
+                hfiParm.qWeight, (int16_t)(qVelPll - hfiParm.qVelHfi)) >> 15);
+
+        /* Square wave amplitude faded out with the weight */
+        qVdInject = (int16_t)(__builtin_mulss(hfiParm.qVInject,
+                                    Q15(0.9999) - hfiParm.qWeight) >> 15);
+        if (hfiParm.qLastVdInject > 0)
+        {
+            qVdInject = -qVdInject;
+        }
+        hfiParm.qVdInject = qVdInject;
+    }
+    else
+    {
+        /* PLL estimator only */
+        HFISync(qRhoPll, qVelPll);
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    HFISync()
+
+  Summary:
+    Sets the angle and speed of the high frequency injection estimator
+
+  Description:
+    The tracking loop, the blended outputs and the injection are
+    reinitialized to the given angle and speed.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qRho - angle
+    qVel - speed
+
+  Returns:
+    None.
+
+  Remarks:
+    Used when the angle is provided by another source - initial position
+    detection, flying start or the PLL estimator above the blending range.
+ */
+void HFISync(int16_t qRho, int16_t qVel)
+{
+    hfiParm.qRhoHfi = qRho;
+    hfiParm.qRhoStateVar = (int32_t)qRho << 15;
+    hfiParm.qOmega = qVel;
+    hfiParm.qOmegaStateVar = (int32_t)qVel << HFI_PLL_SCALE;
+    hfiParm.qVelHfi = qVel;
+    hfiParm.qVelStateVar = (int32_t)qVel << 15;
+    hfiParm.qRho = qRho;
+    hfiParm.qVel = qVel;
+    hfiParm.qError = 0;
+    hfiParm.qVdInject = 0;
+    hfiParm.qLastVdInject = 0;
+    hfiParm.qDemodVdInject = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    HFIInject()
+
+  Summary:
+    Superimposes the injection voltage on the d-axis voltage
+
+  Description:
+    The injection voltage calculated by HFIEstimate() is added to the d-axis
+    voltage reference and the injection history used for the demodulation is
+    updated.
+
+  Precondition:
+    Called once every control cycle after the current controllers.
+
+  Parameters:
+    pVdq - pointer to the d-q voltages
+
+  Returns:
+    None.
+
+  Remarks:
+    The result is limited to the Q15 range, the dynamic d-q limitation of the
+    current controllers leaves margin for the injection amplitude.
+ */
+void HFIInject(MC_DQ_T *pVdq)
+{
+    int32_t vd = (int32_t)pVdq->d + hfiParm.qVdInject;
+
+    if (vd > Q15(0.9999))
+    {
+        vd = Q15(0.9999);
+    }
+    else if (vd < Q15(-0.9999))
+    {
+        vd = Q15(-0.9999);
+    }
+    pVdq->d = (int16_t)vd;
+
+    hfiParm.qDemodVdInject = hfiParm.qLastVdInject;
+    hfiParm.qLastVdInject = hfiParm.qVdInject;
+}
+
+// </editor-fold>
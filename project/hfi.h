@@ -0,0 +1,128 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file hfi.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the high frequency injection angle estimator
+ *
+ * Component: HFI - ESTIMATOR
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __HFI_H
+#define __HFI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* HFI Estimator Parameter data type
+
+  Description:
+    This structure will host parameters related to the high frequency
+    injection angle estimator and its blending with the PLL estimator.
+ */
+typedef struct
+{
+    /* Amplitude of the square wave voltage injected on the d-axis */
+    int16_t qVInject;
+    /* Voltage injected on the d-axis in this control cycle */
+    int16_t qVdInject;
+    /* Injected voltage of the previous control cycle */
+    int16_t qLastVdInject;
+    /* Injected voltage that produced the latest current difference */
+    int16_t qDemodVdInject;
+    /* d current of previous control cycle */
+    int16_t qLastId;
+    /* q current of previous control cycle */
+    int16_t qLastIq;
+    /* Demodulated angle error signal */
+    int16_t qError;
+    /* Proportional gain of the tracking PLL */
+    int16_t qKp;
+    /* Integral gain of the tracking PLL */
+    int16_t qKi;
+    /* State variable of the tracking PLL integrator */
+    int32_t qOmegaStateVar;
+    /* Speed from the tracking PLL */
+    int16_t qOmega;
+    /* Angle from the tracking PLL */
+    int16_t qRhoHfi;
+    /* State variable for the angle */
+    int32_t qRhoStateVar;
+    /* Filtered speed from the tracking PLL */
+    int16_t qVelHfi;
+    /* State variable for filtered speed */
+    int32_t qVelStateVar;
+    /* Weight of the PLL estimator: 0 - HFI only, 0x7FFF - PLL only */
+    int16_t qWeight;
+    /* Speed at which the blending starts */
+    int16_t qBlendStartSpeed;
+    /* Gain converting speed above qBlendStartSpeed into weight */
+    int16_t qBlendGain;
+    /* Blended angle */
+    int16_t qRho;
+    /* Blended speed */
+    int16_t qVel;
+} HFI_PARM_T;
+
+extern HFI_PARM_T hfiParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitHFIParams(void);
+void HFIDemodulate(MC_DQ_T *pIdq);
+void HFIEstimate(int16_t qRhoPll, int16_t qVelPll);
+void HFISync(int16_t qRho, int16_t qVel);
+void HFIInject(MC_DQ_T *pVdq);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HFI_H */
@@ -0,0 +1,245 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file ipd.c
+ *
+ * @brief This module implements initial rotor position detection of PMSM at
+ * standstill by pulsed voltage injection.
+ *
+ * Component: INITIAL POSITION DETECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "ipd.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+IPD_PARM_T ipdParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static int16_t IPDCalculateRotorAngle(void);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitIPDParams()
+
+  Summary:
+    Initializes initial position detection parameters
+
+  Description:
+    This routine initializes the initial position detection structure
+    variables and restarts the pulse sequence from the first test angle
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitIPDParams(void)
+{
+    uint16_t i;
+
+    ipdParm.qVdPulse = IPD_VOLTAGE;
+    ipdParm.pulseTime = IPD_PULSE_TIME;
+    ipdParm.restTime = IPD_REST_TIME;
+    ipdParm.qVdInject = 0;
+    ipdParm.qTestAngle = 0;
+    ipdParm.qRotorAngle = 0;
+    ipdParm.counter = 0;
+    ipdParm.index = 0;
+    ipdParm.done = 0;
+
+    for (i = 0; i < IPD_TEST_ANGLES; i++)
+    {
+        ipdParm.qIdPeak[i] = 0;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    IPDStep()
+
+  Summary:
+    Executes one control cycle of the initial position detection
+
+  Description:
+    For each test angle a positive voltage pulse is applied along the angle,
+    the current response along the same angle is sampled at the end of the
+    pulse, and a negative pulse of equal length returns the current to zero
+    before a rest time. Because of magnetic saliency and saturation of the
+    stator iron by the magnet, the response is largest when the test angle
+    is aligned with the magnet north pole; this also resolves the polarity.
+
+  Precondition:
+    The park angle must be set to ipdParm.qTestAngle and the voltage
+    ipdParm.qVdInject applied on the d-axis with zero q-axis voltage.
+
+  Parameters:
+    qIdMeasured - current along the test angle (d-axis current)
+
+  Returns:
+    1 when the detection is completed, 0 otherwise.
+
+  Remarks:
+    None.
+ */
+uint16_t IPDStep(int16_t qIdMeasured)
+{
+    if (ipdParm.done == 0)
+    {
+        if (ipdParm.counter < ipdParm.pulseTime)
+        {
+            /* Positive pulse along the test angle */
+            ipdParm.qVdInject = ipdParm.qVdPulse;
+        }
+        else if (ipdParm.counter < (ipdParm.pulseTime << 1))
+        {
+            if (ipdParm.counter == ipdParm.pulseTime)
+            {
+                /* Current response at the end of the positive pulse */
+                ipdParm.qIdPeak[ipdParm.index] = qIdMeasured;
+            }
+            /* Negative pulse to bring the current back to zero */
+            ipdParm.qVdInject = -ipdParm.qVdPulse;
+        }
+        else
+        {
+            ipdParm.qVdInject = 0;
+        }
+
+        ipdParm.counter++;
+
+        if (ipdParm.counter >= ((ipdParm.pulseTime << 1) + ipdParm.restTime))
+        {
+            ipdParm.counter = 0;
+            ipdParm.index++;
+
+            if (ipdParm.index < IPD_TEST_ANGLES)
+            {
+                ipdParm.qTestAngle = (int16_t)(ipdParm.index *
+                                                (uint16_t)IPD_ANGLE_STEP);
+            }
+            else
+            {
+                ipdParm.qRotorAngle = IPDCalculateRotorAngle();
+                ipdParm.done = 1;
+            }
+        }
+    }
+    return ipdParm.done;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    IPDCalculateRotorAngle()
+
+  Summary:
+    Calculates the rotor angle from the measured current responses
+
+  Description:
+    The test angle with the largest current response is selected and the
+    angle is refined by parabolic interpolation with the responses of the
+    two neighbouring test angles.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    Rotor angle.
+
+  Remarks:
+    None.
+ */
+static int16_t IPDCalculateRotorAngle(void)
+{
+    uint16_t i, maxIndex = 0;
+    int16_t iPrev, iMax, iNext, den, delta = 0;
+
+    for (i = 1; i < IPD_TEST_ANGLES; i++)
+    {
+        if (ipdParm.qIdPeak[i] > ipdParm.qIdPeak[maxIndex])
+        {
+            maxIndex = i;
+        }
+    }
+
+    /* Responses are scaled down by 4 so that the sums below fit in Q15 */
+    iMax = ipdParm.qIdPeak[maxIndex] >> 2;
+    iPrev = ipdParm.qIdPeak[(maxIndex + IPD_TEST_ANGLES - 1) % IPD_TEST_ANGLES] >> 2;
+    iNext = ipdParm.qIdPeak[(maxIndex + 1) % IPD_TEST_ANGLES] >> 2;
+
+    /* Vertex of the parabola through the three responses,
+       delta = step * (iNext - iPrev) / (2 * (2*iMax - iPrev - iNext))
+       since iMax is the largest response |delta| <= step/2 */
+    den = (iMax << 1) - iPrev - iNext;
+    if (den > 0)
+    {
+        delta = __builtin_divsd(__builtin_mulss(IPD_ANGLE_STEP,
+                                                iNext - iPrev), den) >> 1;
+    }
+
+    return (int16_t)(maxIndex * (uint16_t)IPD_ANGLE_STEP) + delta;
+}
+
+// </editor-fold>
@@ -0,0 +1,111 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file ipd.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the initial rotor position detection module
+ *
+ * Component: INITIAL POSITION DETECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __IPD_H
+#define __IPD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Number of test angles evenly distributed over one electrical revolution */
+#define IPD_TEST_ANGLES         12
+/* Angle between two consecutive test angles (65536 = 360 deg) */
+#define IPD_ANGLE_STEP          (int16_t)(65536UL/IPD_TEST_ANGLES)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Initial Position Detection Parameter data type
+
+  Description:
+    This structure will host parameters related to the initial rotor position
+    detection function.
+ */
+typedef struct
+{
+    /* Voltage pulse amplitude applied along the test angle */
+    int16_t qVdPulse;
+    /* Voltage applied along the test angle in this control cycle */
+    int16_t qVdInject;
+    /* Test angle presently applied */
+    int16_t qTestAngle;
+    /* Detected rotor (d-axis) angle */
+    int16_t qRotorAngle;
+    /* Cycle counter within one test angle */
+    uint16_t counter;
+    /* Index of the test angle presently applied */
+    uint16_t index;
+    /* Duration of the voltage pulse in ADC ISR cycles */
+    uint16_t pulseTime;
+    /* Current decay time after the pulse in ADC ISR cycles */
+    uint16_t restTime;
+    /* Peak current response measured at each test angle */
+    int16_t qIdPeak[IPD_TEST_ANGLES];
+    /* Detection completed indication */
+    uint16_t done;
+} IPD_PARM_T;
+
+extern IPD_PARM_T ipdParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitIPDParams(void);
+uint16_t IPDStep(int16_t qIdMeasured);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IPD_H */
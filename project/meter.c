@@ -0,0 +1,262 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file meter.c
+ *
+ * @brief This module calculates the electrical power at the motor terminals,
+ * the input power from the DC bus, the electromagnetic torque and counts the
+ * energy taken from and returned to the DC bus.
+ *
+ * Component: METERING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include "meter.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+#include "estim.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Electrical power 1.5*(vd*id + vq*iq) scaled to METER_POWER_BASE_W. Without
+   DC_BUS_COMPENSATION it is further multiplied by the measured bus voltage,
+   relative to DC_BUS_VOLTAGE_FULL_SCALE */
+#ifdef DC_BUS_COMPENSATION
+#define METER_POWER_SCALE       Q15(1.5*METER_VOLTAGE_BASE/ \
+                                    DC_BUS_VOLTAGE_FULL_SCALE)
+#else
+#define METER_POWER_SCALE       Q15(1.5/1.7320508/NORM_VOLTAGE_BASE_RATIO)
+#endif
+/* Filter constant of the filtered power and torque */
+#define METER_FILTER_KFILTER    Q15(6.2831853*METER_FILTER_HZ*LOOPTIME_SEC)
+/* Input power summed over the control cycles of one watt hour */
+#define METER_COUNTS_PER_WH     (int32_t)(3600.0*32768.0/ \
+                                    (METER_POWER_BASE_W*LOOPTIME_SEC))
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+METER_PARM_T meterParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitMeterParams()
+
+  Summary:
+    Initializes metering parameters
+
+  Description:
+    This routine clears the power, torque and energy counters.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the energy counters are kept when the control
+    is reinitialized.
+ */
+void InitMeterParams(void)
+{
+    meterParm.qIbus = 0;
+    meterParm.qPower = 0;
+    meterParm.qPowerBus = 0;
+    meterParm.qTorque = 0;
+    MCAPP_FilterLPFInit(&meterParm.powerFilter, METER_FILTER_KFILTER, 0);
+    MCAPP_FilterLPFInit(&meterParm.powerBusFilter, METER_FILTER_KFILTER, 0);
+    MCAPP_FilterLPFInit(&meterParm.torqueFilter, METER_FILTER_KFILTER, 0);
+    meterParm.energyFraction = 0;
+    meterParm.energyWh = 0;
+    meterParm.energyRegenWh = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    MeterBusCurrent()
+
+  Summary:
+    Calculates the mean DC bus current
+
+  Description:
+    This routine calculates the mean bus current of the last PWM period from
+    the two bus current samples of the single shunt reconstruction, each
+    weighted with the duration of its active vector, (T1*Ibus1 + T2*Ibus2)/T.
+    No current flows in the bus during the zero vectors.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pSingleShunt - Single shunt parameters of the last PWM period
+
+  Returns:
+    None.
+
+  Remarks:
+    Called after the phase current reconstruction and before the space
+    vector modulation of the next period overwrites T1 and T2.
+ */
+void MeterBusCurrent(const SINGLE_SHUNT_PARM_T *pSingleShunt)
+{
+    meterParm.qIbus = __builtin_divsd(
+            __builtin_mulss(pSingleShunt->T1, pSingleShunt->Ibus1) +
+            __builtin_mulss(pSingleShunt->T2, pSingleShunt->Ibus2),
+            LOOPTIME_TCY);
+}
+// *****************************************************************************
+
+/* Function:
+    MeterStepIsr()
+
+  Summary:
+    Power, torque and energy metering
+
+  Description:
+    This routine calculates the electrical power from the d-q voltages and
+    currents and the input power from the DC bus voltage and the mean bus
+    current. Without single shunt, the bus current is not sampled while the
+    motor runs and the input power is the electrical power. Without DC bus
+    compensation the d-q voltages are relative to the bus voltage, so the
+    measured one sets their scale. The torque is
+    1.5*p*psi*Iq, with the reluctance torque of MTPA included by the
+    extended flux of the estimator. The input energy is summed every
+    control cycle and carried into the watt hour counters.
+
+  Precondition:
+    InitMeterParams() is called before.
+
+  Parameters:
+    running - Nonzero while the motor is controlled
+    pVdq    - Output voltage vector of the last control cycle
+    pIdq    - Measured d-q currents
+    qVdc    - DC bus voltage
+
+  Returns:
+    None.
+
+  Remarks:
+    Called every PWM period, the power and torque are zero while the motor
+    is stopped.
+ */
+void MeterStepIsr(uint16_t running, const MC_DQ_T *pVdq, const MC_DQ_T *pIdq,
+                  int16_t qVdc)
+{
+    int32_t temp;
+
+    if (running != 0)
+    {
+        temp = (__builtin_mulss(pVdq->d, pIdq->d) +
+                __builtin_mulss(pVdq->q, pIdq->q)) >> 15;
+        if (temp > INT16_MAX)
+        {
+            temp = INT16_MAX;
+        }
+        else if (temp < -INT16_MAX)
+        {
+            temp = -INT16_MAX;
+        }
+#ifdef DC_BUS_COMPENSATION
+        meterParm.qPower = (int16_t)(__builtin_mulss((int16_t)temp,
+                                                     METER_POWER_SCALE) >> 15);
+#else
+        meterParm.qPower = (int16_t)(__builtin_mulss((int16_t)temp,
+                (int16_t)(__builtin_mulss(qVdc, METER_POWER_SCALE) >> 15))
+                                                                    >> 15);
+#endif
+#ifdef SINGLE_SHUNT
+        meterParm.qPowerBus = (int16_t)(__builtin_mulss(qVdc,
+                                                        meterParm.qIbus) >> 15);
+#else
+        meterParm.qPowerBus = meterParm.qPower;
+#endif
+#ifdef MTPA
+        /* Iq*psi_ext/psi, the inverse flux constant is scaled by MTPA */
+        temp = __builtin_mulss(pIdq->q, motorParm.qInvKFiBase);
+        if (temp >= ((int32_t)motorParm.qInvKFi << 15))
+        {
+            meterParm.qTorque = INT16_MAX;
+        }
+        else if (temp <= -((int32_t)motorParm.qInvKFi << 15))
+        {
+            meterParm.qTorque = -INT16_MAX;
+        }
+        else
+        {
+            meterParm.qTorque = __builtin_divsd(temp, motorParm.qInvKFi);
+        }
+#else
+        meterParm.qTorque = pIdq->q;
+#endif
+    }
+    else
+    {
+        meterParm.qPower = 0;
+        meterParm.qPowerBus = 0;
+        meterParm.qTorque = 0;
+    }
+    MCAPP_FilterLPF(&meterParm.powerFilter, meterParm.qPower);
+    MCAPP_FilterLPF(&meterParm.powerBusFilter, meterParm.qPowerBus);
+    MCAPP_FilterLPF(&meterParm.torqueFilter, meterParm.qTorque);
+
+    meterParm.energyFraction += meterParm.qPowerBus;
+    if (meterParm.energyFraction >= METER_COUNTS_PER_WH)
+    {
+        meterParm.energyFraction -= METER_COUNTS_PER_WH;
+        meterParm.energyWh++;
+    }
+    else if (meterParm.energyFraction <= -METER_COUNTS_PER_WH)
+    {
+        meterParm.energyFraction += METER_COUNTS_PER_WH;
+        meterParm.energyRegenWh++;
+    }
+}
+
+// </editor-fold>
@@ -0,0 +1,123 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file meter.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the electrical power, torque and energy metering
+ *
+ * Component: METERING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __METER_H
+#define __METER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+#include "userparms.h"
+#include "filter.h"
+#include "singleshunt.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Voltage base of the normalized d-q voltages, peak phase voltage. It is
+   fixed with DC_BUS_COMPENSATION, otherwise the d-q voltages are relative to
+   the measured bus voltage and so is their base */
+#define METER_VOLTAGE_BASE      (DC_BUS_VOLTAGE_NOMINAL/1.7320508/ \
+                                    NORM_VOLTAGE_BASE_RATIO)
+/* Current base of the normalized currents, peak phase current */
+#define METER_CURRENT_BASE      (NORM_CURRENT_CONST*32768.0)
+/* Power in watts of Q15(1.0) of meterParm.qPower and qPowerBus */
+#define METER_POWER_BASE_W      (DC_BUS_VOLTAGE_FULL_SCALE*METER_CURRENT_BASE)
+/* Torque in newton meters of Q15(1.0) of meterParm.qTorque */
+#define METER_TORQUE_BASE_NM    (MOTOR_TORQUE_CONSTANT*METER_CURRENT_BASE)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Metering Parameter data type
+
+  Description:
+    This structure will host the electrical power at the motor terminals,
+    the input power from the DC bus, the electromagnetic torque, their
+    filtered values and the energy counters, to be read with X2CScope.
+ */
+typedef struct
+{
+    /* Mean DC bus current of the last PWM period, single shunt only */
+    int16_t qIbus;
+    /* Electrical power 1.5*(vd*id + vq*iq), METER_POWER_BASE_W base */
+    int16_t qPower;
+    /* Input power from the DC bus voltage and current */
+    int16_t qPowerBus;
+    /* Electromagnetic torque from Iq, METER_TORQUE_BASE_NM base */
+    int16_t qTorque;
+    /* Filtered power, input power and torque */
+    MCAPP_FILTER_LPF_T powerFilter;
+    MCAPP_FILTER_LPF_T powerBusFilter;
+    MCAPP_FILTER_LPF_T torqueFilter;
+    /* Input energy below one watt hour, positive or negative */
+    int32_t energyFraction;
+    /* Energy taken from and returned to the DC bus in watt hours */
+    uint32_t energyWh;
+    uint32_t energyRegenWh;
+} METER_PARM_T;
+
+extern METER_PARM_T meterParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitMeterParams(void);
+void MeterBusCurrent(const SINGLE_SHUNT_PARM_T *pSingleShunt);
+void MeterStepIsr(uint16_t running, const MC_DQ_T *pVdq, const MC_DQ_T *pIdq,
+                  int16_t qVdc);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __METER_H */
@@ -0,0 +1,302 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file mtpa.c
+ *
+ * @brief This module selects the d-q current operating point of an interior
+ * permanent magnet motor: the maximum torque per ampere d current below the
+ * voltage limit, field weakening from the output voltage above it, bounded by
+ * the characteristic current and the current limit. The estimator flux is
+ * corrected for the saliency.
+ *
+ * Component: MTPA
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "mtpa.h"
+#include "general.h"
+#include "userparms.h"
+#include "estim.h"
+#include "thermal.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Normalized current limited to the Q15 range */
+#define MTPA_CURRENT_LIMIT(x)   (int16_t)(((x) > 32767.0) ? 32767.0 : (x))
+/* psi/(2*(Lq - Ld)), the MTPA d current is a - sqrt(a^2 + Iq^2) */
+#define MTPA_A                  MTPA_CURRENT_LIMIT(MOTOR_FLUX_LINKAGE/ \
+                                    (2.0*(MOTOR_LQ - MOTOR_LD))/ \
+                                    NORM_CURRENT_CONST)
+/* Characteristic current psi/Ld, the d current beyond which the torque per
+   volt decreases */
+#define MTPA_ID_CHARACTERISTIC  MTPA_CURRENT_LIMIT(MOTOR_FLUX_LINKAGE/ \
+                                    MOTOR_LD/NORM_CURRENT_CONST)
+/* Largest negative d current */
+#define MTPA_ID_FW_MAX          NORM_CURRENT(MTPA_FW_CURRENT_MAX)
+/* Squared voltage vector magnitude where the field weakening starts */
+#define MTPA_FW_VOLTAGE_SQUARE  Q15(MTPA_FW_VOLTAGE*MTPA_FW_VOLTAGE)
+/* Field weakening integral gain */
+#define MTPA_FW_KI_Q15          Q15(MTPA_FW_KI)
+/* sqrt(2) in Q14 */
+#define MTPA_SQRT2_Q14          23170
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+MTPA_PARM_T mtpaParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    MtpaId()
+
+  Summary:
+    Calculates the maximum torque per ampere d current
+
+  Description:
+    This routine solves the MTPA condition psi*Id = (Lq - Ld)*(Id^2 - Iq^2)
+    for the d current, Id = a - sqrt(a^2 + Iq^2) with a = psi/(2*(Lq - Ld)).
+    It is calculated as Id = -Iq^2/(a + sqrt(a^2 + Iq^2)), which keeps its
+    resolution when a is large compared to Iq.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qIq - q current reference
+
+  Returns:
+    d current reference, zero or negative.
+
+  Remarks:
+    The magnitude of the result is below the magnitude of qIq.
+ */
+static int16_t MtpaId(int16_t qIq)
+{
+    int32_t iqSquare;
+    int32_t denominator;
+    int16_t halfSquare;
+
+    iqSquare = __builtin_mulss(qIq, qIq);
+    /* (a^2 + Iq^2)/2 stays within the Q15 range */
+    halfSquare = (int16_t)((__builtin_mulss(MTPA_A, MTPA_A) + iqSquare) >> 16);
+    denominator = MTPA_A + ((__builtin_mulss(_Q15sqrt(halfSquare),
+                                             MTPA_SQRT2_Q14)) >> 14);
+    /* Denominator is below 3*32768 */
+    while (denominator > INT16_MAX)
+    {
+        denominator >>= 1;
+        iqSquare >>= 1;
+    }
+    return -(int16_t)__builtin_divsd(iqSquare, (int16_t)denominator);
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    MtpaReset()
+
+  Summary:
+    Resets the operating point selection
+
+  Description:
+    This routine clears the field weakening correction and returns the
+    estimator to the magnet flux.
+
+  Precondition:
+    InitEstimParm() is called before.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called when the control is reinitialized.
+ */
+void MtpaReset(void)
+{
+    mtpaParm.qIdMtpa = 0;
+    mtpaParm.qIdFw = 0;
+    mtpaParm.fwStateVar = 0;
+    mtpaParm.qVoltageSquare = 0;
+    mtpaParm.qIdRef = 0;
+    mtpaParm.qIqLimit = (int16_t)SPEEDCNTR_OUTMAX;
+    motorParm.qInvKFi = motorParm.qInvKFiBase;
+}
+// *****************************************************************************
+
+/* Function:
+    MtpaCurrentRef()
+
+  Summary:
+    Selects the d-q current operating point
+
+  Description:
+    This routine calculates the d current reference as the MTPA d current
+    for the q current reference plus a field weakening correction. The
+    correction integrates the difference between the squared output voltage
+    magnitude and MTPA_FW_VOLTAGE squared, it becomes negative when the
+    voltage limit is approached and returns to zero below it. The d current
+    is limited to the characteristic current psi/Ld, an approximation of
+    the maximum torque per volt limit, to MTPA_FW_CURRENT_MAX and to the
+    current limit. The q
+    current is then limited to the remaining current within the current
+    limit.
+    The estimator BEMF calculated with Lq is the extended BEMF
+    omega*(psi + (Lq - Ld)*|Id|), its inverse flux constant is scaled
+    accordingly.
+
+  Precondition:
+    MtpaReset() is called before.
+
+  Parameters:
+    qIqRef - q current reference
+    pVdq   - Output voltage vector of the last control cycle
+
+  Returns:
+    q current reference within the current limit, the d current reference is
+    mtpaParm.qIdRef.
+
+  Remarks:
+    Called in closed loop every control cycle.
+ */
+int16_t MtpaCurrentRef(int16_t qIqRef, const MC_DQ_T *pVdq)
+{
+    int16_t currentLimit;
+    int16_t idMin;
+    int16_t idMagnitude;
+    int16_t divisor;
+    int32_t fwMin;
+    int32_t temp;
+
+#ifdef THERMAL_PROTECTION
+    currentLimit = thermalParm.qIqLimit;
+#else
+    currentLimit = (int16_t)SPEEDCNTR_OUTMAX;
+#endif
+    idMin = -currentLimit;
+    if (-MTPA_ID_FW_MAX > idMin)
+    {
+        idMin = -MTPA_ID_FW_MAX;
+    }
+    if (-MTPA_ID_CHARACTERISTIC > idMin)
+    {
+        idMin = -MTPA_ID_CHARACTERISTIC;
+    }
+
+    mtpaParm.qIdMtpa = MtpaId(qIqRef);
+
+    /* Field weakening correction from the voltage headroom */
+    temp = (__builtin_mulss(pVdq->d, pVdq->d) +
+            __builtin_mulss(pVdq->q, pVdq->q)) >> 15;
+    if (temp > INT16_MAX)
+    {
+        temp = INT16_MAX;
+    }
+    mtpaParm.qVoltageSquare = (int16_t)temp;
+    mtpaParm.fwStateVar += __builtin_mulss(MTPA_FW_VOLTAGE_SQUARE -
+                                           mtpaParm.qVoltageSquare,
+                                           MTPA_FW_KI_Q15);
+    fwMin = (int32_t)(idMin - mtpaParm.qIdMtpa) << 15;
+    if (mtpaParm.fwStateVar < fwMin)
+    {
+        mtpaParm.fwStateVar = fwMin;
+    }
+    if (mtpaParm.fwStateVar > 0)
+    {
+        mtpaParm.fwStateVar = 0;
+    }
+    mtpaParm.qIdFw = (int16_t)(mtpaParm.fwStateVar >> 15);
+
+    mtpaParm.qIdRef = mtpaParm.qIdMtpa + mtpaParm.qIdFw;
+    if (mtpaParm.qIdRef < idMin)
+    {
+        mtpaParm.qIdRef = idMin;
+    }
+
+    /* q current within the current limit */
+    temp = (__builtin_mulss(currentLimit, currentLimit) -
+            __builtin_mulss(mtpaParm.qIdRef, mtpaParm.qIdRef)) >> 15;
+    mtpaParm.qIqLimit = _Q15sqrt((int16_t)temp);
+    if (qIqRef > mtpaParm.qIqLimit)
+    {
+        qIqRef = mtpaParm.qIqLimit;
+    }
+    else if (qIqRef < -mtpaParm.qIqLimit)
+    {
+        qIqRef = -mtpaParm.qIqLimit;
+    }
+
+    /* Inverse extended flux, 1/psi*2a/(2a + |Id|) */
+    idMagnitude = -mtpaParm.qIdRef;
+    divisor = (int16_t)((2*(int32_t)MTPA_A + idMagnitude) >> 2);
+    /* For a below 2 the divisor is zero at zero d current */
+    if (divisor < 1)
+    {
+        divisor = 1;
+    }
+    /* The ratio |Id|/(2a + |Id|) reaches one for a small a, the quotient
+    would overflow */
+    if (idMagnitude >= ((int32_t)divisor << 2))
+    {
+        temp = Q15(0.9999);
+    }
+    else
+    {
+        temp = __builtin_divsd((int32_t)idMagnitude << 13, divisor);
+    }
+    motorParm.qInvKFi = (int16_t)(__builtin_mulss(motorParm.qInvKFiBase,
+                                                  Q15(0.9999) - temp) >> 15);
+
+    return qIqRef;
+}
+
+// </editor-fold>
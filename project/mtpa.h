@@ -0,0 +1,100 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file mtpa.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the maximum torque per ampere d-axis current reference with the voltage
+ * limit field weakening
+ *
+ * Component: MTPA
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __MTPA_H
+#define __MTPA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* MTPA Parameter data type
+
+  Description:
+    This structure will host parameters related to the selection of the
+    d-q current operating point: the maximum torque per ampere d current,
+    the field weakening correction from the voltage limit, the lower limit
+    of the d current and the current limit of the q current.
+ */
+typedef struct
+{
+    /* d current for the maximum torque per ampere */
+    int16_t qIdMtpa;
+    /* Field weakening correction of the d current, zero or negative */
+    int16_t qIdFw;
+    /* Field weakening integrator, with 15 fractional bits */
+    int32_t fwStateVar;
+    /* Squared magnitude of the last output voltage vector */
+    int16_t qVoltageSquare;
+    /* d current reference */
+    int16_t qIdRef;
+    /* q current limit left by the d current within the current limit */
+    int16_t qIqLimit;
+} MTPA_PARM_T;
+
+extern MTPA_PARM_T mtpaParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void MtpaReset(void);
+int16_t MtpaCurrentRef(int16_t qIqRef, const MC_DQ_T *pVdq);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MTPA_H */
@@ -0,0 +1,525 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file notch.c
+ *
+ * @brief This module implements notch filters on the speed controller output
+ * that suppress a mechanical resonance, and a Goertzel detector that tunes
+ * the first notch to the resonance frequency found in the Iq current.
+ *
+ * Component: NOTCH FILTER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "notch.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Gain converting a frequency in Hz into the centre frequency coefficient 
+   2*sin(pi*f/fs) ~ 2*pi*f/fs, with 8 more fractional bits */
+#define NOTCH_F_GAIN            (int16_t)(6.2832*LOOPTIME_SEC*32768.0*256.0)
+/* Damping coefficient and depth in Q14 */
+#define NOTCH_DAMPING           (int16_t)(16384.0/NOTCH_QUALITY)
+#define NOTCH_DEPTH_DAMPING     (int16_t)(16384.0*NOTCH_DEPTH/NOTCH_QUALITY)
+
+#ifdef NOTCH_ADAPTIVE
+/* The Iq samples are averaged over NOTCH_DETECT_BINS control cycles, each
+   cycle updates one detector frequency with the last decimated sample */
+#define NOTCH_DETECT_DECIMATION NOTCH_DETECT_BINS
+#define NOTCH_DETECT_DECIMATION_SHIFT NOTCH_DETECT_BINS_SHIFT
+/* Decimated samples per detection block */
+#define NOTCH_DETECT_BLOCK      64
+/* Sampling frequency of the detector */
+#define NOTCH_DETECT_FS_HZ      (PWMFREQUENCY_HZ/NOTCH_DETECT_DECIMATION)
+/* Spacing of the detector frequencies in Hz */
+#define NOTCH_DETECT_SPACING_HZ ((NOTCH_DETECT_MAX_HZ - NOTCH_DETECT_MIN_HZ)/ \
+                                    (NOTCH_DETECT_BINS - 1))
+/* Filter constant of the mean value of the decimated Iq, 5Hz */
+#define NOTCH_DETECT_KMEAN      Q15(6.2832*5.0/NOTCH_DETECT_FS_HZ)
+/* Shift of the Goertzel state variables for the power calculation */
+#define NOTCH_DETECT_POWER_SHIFT 2
+/* Power of a sine wave of amplitude NOTCH_DETECT_AMPLITUDE, the magnitude
+   N/2 * amplitude in the scaling of the power calculation */
+#define NOTCH_DETECT_POWER      ((int32_t)NOTCH_DETECT_AMPLITUDE* \
+                                    NOTCH_DETECT_AMPLITUDE* \
+                                    (NOTCH_DETECT_BLOCK/2)* \
+                                    (NOTCH_DETECT_BLOCK/2)/64)
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+NOTCH_PARM_T notchParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static void NotchSetFrequency(NOTCH_FILTER_T *pFilter, int16_t frequency);
+static int16_t NotchFilterStep(NOTCH_FILTER_T *pFilter, int16_t qInput);
+static int16_t NotchSaturate(int32_t value);
+#ifdef NOTCH_ADAPTIVE
+static void NotchDetectBlock(void);
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitNotchParams()
+
+  Summary:
+    Initializes notch filter parameters
+
+  Description:
+    This routine initializes the notch filter coefficients to
+    NOTCH1_FREQUENCY_HZ and NOTCH2_FREQUENCY_HZ, the coefficients of the
+    resonance detector and resets the filter states.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the adapted frequency is kept when the motor is
+    stopped and restarted.
+ */
+void InitNotchParams(void)
+{
+    uint16_t i;
+#ifdef NOTCH_ADAPTIVE
+    MC_SINCOS_T sincos;
+    int16_t frequency;
+#endif
+
+    for (i = 0; i < NOTCH_FILTER_COUNT; i++)
+    {
+        notchParm.filter[i].qDamping = NOTCH_DAMPING;
+        notchParm.filter[i].qDepth = NOTCH_DEPTH_DAMPING;
+    }
+    notchParm.frequency = NOTCH1_FREQUENCY_HZ;
+    NotchSetFrequency(&notchParm.filter[0], NOTCH1_FREQUENCY_HZ);
+#if (NOTCH_FILTER_COUNT > 1)
+    NotchSetFrequency(&notchParm.filter[1], NOTCH2_FREQUENCY_HZ);
+#endif
+
+#ifdef NOTCH_ADAPTIVE
+    for (i = 0; i < NOTCH_DETECT_BINS; i++)
+    {
+        /* 2*cos(2*pi*f/fs) in Q14 is cos(2*pi*f/fs) in Q15 */
+        frequency = NOTCH_DETECT_MIN_HZ + i * NOTCH_DETECT_SPACING_HZ;
+        MC_CalculateSineCosine_Assembly_Ram((int16_t)(((int32_t)frequency 
+                                << 16) / NOTCH_DETECT_FS_HZ), &sincos);
+        notchParm.qCoeff[i] = sincos.cos;
+    }
+    notchParm.detectedFrequency = 0;
+#endif
+
+    NotchReset();
+}
+// *****************************************************************************
+
+/* Function:
+    NotchReset()
+
+  Summary:
+    Resets the notch filter and detector states
+
+  Description:
+    The filter states and the detection block are cleared, the centre
+    frequencies are not changed.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called when the motor is stopped.
+ */
+void NotchReset(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < NOTCH_FILTER_COUNT; i++)
+    {
+        notchParm.filter[i].qLow = 0;
+        notchParm.filter[i].lowStateVar = 0;
+        notchParm.filter[i].qBand = 0;
+        notchParm.filter[i].bandStateVar = 0;
+    }
+
+#ifdef NOTCH_ADAPTIVE
+    for (i = 0; i < NOTCH_DETECT_BINS; i++)
+    {
+        notchParm.s1[i] = 0;
+        notchParm.s2[i] = 0;
+        notchParm.power[i] = 0;
+    }
+    notchParm.decimationSum = 0;
+    notchParm.decimationCount = 0;
+    notchParm.qSample = 0;
+    notchParm.qMean = 0;
+    notchParm.meanStateVar = 0;
+    notchParm.sampleCount = 0;
+#endif
+}
+// *****************************************************************************
+
+/* Function:
+    NotchFilter()
+
+  Summary:
+    Filters the speed controller output with the notch filters
+
+  Description:
+    Each notch filter is a second order state variable filter,
+    low = low + F*band, high = x - low - D*band, band = band + F*high, with
+    the output x - depth*D*band. The band pass output D*band has unity gain
+    at the centre frequency, band alone has the gain 1/D, so the output is
+    attenuated there by the depth. Unlike
+    the direct form biquad, whose coefficients approach 2 and 1 for a centre
+    frequency much lower than the sampling frequency, the coefficient F is
+    proportional to the centre frequency and keeps its resolution in Q15.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    qInput - speed controller output
+
+  Returns:
+    Filtered speed controller output.
+
+  Remarks:
+    None.
+ */
+int16_t NotchFilter(int16_t qInput)
+{
+    int16_t qOutput = NotchFilterStep(&notchParm.filter[0], qInput);
+
+#if (NOTCH_FILTER_COUNT > 1)
+    qOutput = NotchFilterStep(&notchParm.filter[1], qOutput);
+#endif
+    return qOutput;
+}
+#ifdef NOTCH_ADAPTIVE
+// *****************************************************************************
+
+/* Function:
+    NotchDetect()
+
+  Summary:
+    Detects the resonance frequency in the Iq current
+
+  Description:
+    The Iq current is averaged over NOTCH_DETECT_BINS control cycles and its
+    mean value is removed. Every control cycle one of the NOTCH_DETECT_BINS
+    Goertzel filters, equally spaced from NOTCH_DETECT_MIN_HZ to
+    NOTCH_DETECT_MAX_HZ, is updated with the last decimated sample,
+    s = x + 2*cos(w)*s1 - s2. After NOTCH_DETECT_BLOCK decimated samples the
+    power at each frequency is evaluated by NotchDetectBlock().
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    qIq - measured Iq current
+
+  Returns:
+    None.
+
+  Remarks:
+    The state variables are 32 bits, the product with the Q14 coefficient
+    is split in the upper and the lower 16 bits.
+ */
+void NotchDetect(int16_t qIq)
+{
+    uint16_t bin = notchParm.decimationCount;
+    int32_t s1 = notchParm.s1[bin];
+    int32_t s;
+
+    /* s = x + coeff*s1 - s2, coeff in Q14 */
+    s = ((__builtin_mulss(notchParm.qCoeff[bin], (int16_t)(s1 >> 16))) << 2)
+        + (__builtin_mulsu(notchParm.qCoeff[bin], (uint16_t)s1) >> 14)
+        + notchParm.qSample - notchParm.s2[bin];
+    notchParm.s2[bin] = s1;
+    notchParm.s1[bin] = s;
+
+    notchParm.decimationSum += qIq;
+    notchParm.decimationCount++;
+    if (notchParm.decimationCount >= NOTCH_DETECT_DECIMATION)
+    {
+        notchParm.decimationCount = 0;
+
+        /* All frequencies are updated with the sample */
+        notchParm.sampleCount++;
+        if (notchParm.sampleCount >= NOTCH_DETECT_BLOCK)
+        {
+            notchParm.sampleCount = 0;
+            NotchDetectBlock();
+        }
+
+        s = notchParm.decimationSum >> NOTCH_DETECT_DECIMATION_SHIFT;
+        notchParm.decimationSum = 0;
+        notchParm.meanStateVar += __builtin_mulss((int16_t)(s -
+                                    notchParm.qMean), NOTCH_DETECT_KMEAN);
+        notchParm.qMean = (int16_t)(notchParm.meanStateVar >> 15);
+        notchParm.qSample = NotchSaturate(s - notchParm.qMean);
+    }
+}
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    NotchSetFrequency()
+
+  Summary:
+    Sets the centre frequency of a notch filter
+
+  Description:
+    The coefficient 2*sin(pi*f/fs) is approximated by 2*pi*f/fs, the error
+    is below 0.1% up to 500Hz at 20kHz sampling.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pFilter - pointer to the notch filter
+    frequency - centre frequency in Hz
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+static void NotchSetFrequency(NOTCH_FILTER_T *pFilter, int16_t frequency)
+{
+    pFilter->qF = (int16_t)(__builtin_mulss(frequency, NOTCH_F_GAIN) >> 8);
+}
+// *****************************************************************************
+
+/* Function:
+    NotchFilterStep()
+
+  Summary:
+    Executes one notch filter
+
+  Description:
+    See NotchFilter().
+
+  Precondition:
+    None.
+
+  Parameters:
+    pFilter - pointer to the notch filter
+    qInput - filter input
+
+  Returns:
+    Filter output.
+
+  Remarks:
+    None.
+ */
+static int16_t NotchFilterStep(NOTCH_FILTER_T *pFilter, int16_t qInput)
+{
+    int32_t high;
+
+    pFilter->lowStateVar += __builtin_mulss(pFilter->qF, pFilter->qBand);
+    pFilter->qLow = NotchSaturate(pFilter->lowStateVar >> 15);
+
+    high = (int32_t)qInput - pFilter->qLow -
+            (__builtin_mulss(pFilter->qDamping, pFilter->qBand) >> 14);
+    pFilter->bandStateVar += __builtin_mulss(pFilter->qF, NotchSaturate(high));
+    pFilter->qBand = NotchSaturate(pFilter->bandStateVar >> 15);
+
+    return NotchSaturate((int32_t)qInput -
+            (__builtin_mulss(pFilter->qDepth, pFilter->qBand) >> 14));
+}
+// *****************************************************************************
+
+/* Function:
+    NotchSaturate()
+
+  Summary:
+    Limits a value to the Q15 range
+
+  Description:
+    Returns the value limited to -32768 and 32767.
+
+  Precondition:
+    None.
+
+  Parameters:
+    value - 32 bit value
+
+  Returns:
+    Limited value.
+
+  Remarks:
+    None.
+ */
+static int16_t NotchSaturate(int32_t value)
+{
+    if (value > 32767)
+    {
+        value = 32767;
+    }
+    else if (value < -32768)
+    {
+        value = -32768;
+    }
+    return (int16_t)value;
+}
+#ifdef NOTCH_ADAPTIVE
+// *****************************************************************************
+
+/* Function:
+    NotchDetectBlock()
+
+  Summary:
+    Evaluates the detection block and tunes the first notch filter
+
+  Description:
+    The power at each detector frequency, s1*s1 + s2*s2 - coeff*s1*s2, is
+    calculated and the Goertzel filters are cleared. If the largest power
+    exceeds the power of a sine wave of amplitude NOTCH_DETECT_AMPLITUDE,
+    the frequency is refined by parabolic interpolation with the powers of
+    the neighbouring frequencies, and the centre frequency of the first
+    notch filter moves a quarter of the way to it.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    A largest power at either end of the detection range is taken as leakage
+    of low frequency load changes and ignored, the range must include the
+    resonance frequency with some margin.
+ */
+static void NotchDetectBlock(void)
+{
+    uint16_t i, maxIndex = 0;
+    int16_t a, b, tempint, pPrev, pMax, pNext, den, delta = 0;
+    int32_t powerPrev, powerMax, powerNext;
+
+    for (i = 0; i < NOTCH_DETECT_BINS; i++)
+    {
+        a = NotchSaturate(notchParm.s1[i] >> NOTCH_DETECT_POWER_SHIFT);
+        b = NotchSaturate(notchParm.s2[i] >> NOTCH_DETECT_POWER_SHIFT);
+        tempint = NotchSaturate(__builtin_mulss(notchParm.qCoeff[i], a) >> 14);
+        notchParm.power[i] = (__builtin_mulss(a, a) >> 2) +
+                             (__builtin_mulss(b, b) >> 2) -
+                             (__builtin_mulss(tempint, b) >> 2);
+        notchParm.s1[i] = 0;
+        notchParm.s2[i] = 0;
+
+        if (notchParm.power[i] > notchParm.power[maxIndex])
+        {
+            maxIndex = i;
+        }
+    }
+
+    if ((notchParm.power[maxIndex] > NOTCH_DETECT_POWER) &&
+        (maxIndex > 0) && (maxIndex < (NOTCH_DETECT_BINS - 1)))
+    {
+        /* Powers scaled so that the sums below fit in 16 bits */
+        powerPrev = notchParm.power[maxIndex - 1];
+        powerMax = notchParm.power[maxIndex];
+        powerNext = notchParm.power[maxIndex + 1];
+        while (powerMax > 16383)
+        {
+            powerPrev >>= 1;
+            powerMax >>= 1;
+            powerNext >>= 1;
+        }
+        pPrev = (int16_t)powerPrev;
+        pMax = (int16_t)powerMax;
+        pNext = (int16_t)powerNext;
+
+        /* Vertex of the parabola through the three powers */
+        den = (pMax << 1) - pPrev - pNext;
+        if (den > 0)
+        {
+            delta = __builtin_divsd(__builtin_mulss(NOTCH_DETECT_SPACING_HZ,
+                                                    pNext - pPrev), den) >> 1;
+        }
+        notchParm.detectedFrequency = NOTCH_DETECT_MIN_HZ +
+                        (int16_t)(maxIndex * NOTCH_DETECT_SPACING_HZ) + delta;
+
+        notchParm.frequency += (notchParm.detectedFrequency -
+                                notchParm.frequency) >> 2;
+        NotchSetFrequency(&notchParm.filter[0], notchParm.frequency);
+    }
+    else
+    {
+        notchParm.detectedFrequency = 0;
+    }
+}
+#endif
+
+// </editor-fold>
@@ -0,0 +1,149 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file notch.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the resonance notch filters and of the resonance frequency detector
+ *
+ * Component: NOTCH FILTER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __NOTCH_H
+#define __NOTCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Number of frequencies evaluated by the resonance detector, a power of two
+   as it is also the decimation ratio of the Iq samples */
+#define NOTCH_DETECT_BINS_SHIFT 3
+#define NOTCH_DETECT_BINS       (1 << NOTCH_DETECT_BINS_SHIFT)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Notch Filter data type
+
+  Description:
+    This structure will host the coefficients and the state of one second
+    order notch filter in state variable form.
+ */
+typedef struct
+{
+    /* Centre frequency coefficient, 2*sin(pi*f/fs) */
+    int16_t qF;
+    /* Damping coefficient 1/Q, in Q14 */
+    int16_t qDamping;
+    /* Depth multiplied by the damping coefficient, in Q14 */
+    int16_t qDepth;
+    /* Low pass output */
+    int16_t qLow;
+    /* State variable for the low pass output */
+    int32_t lowStateVar;
+    /* Band pass output */
+    int16_t qBand;
+    /* State variable for the band pass output */
+    int32_t bandStateVar;
+} NOTCH_FILTER_T;
+
+/* Notch Filter Parameter data type
+
+  Description:
+    This structure will host parameters related to the notch filters on the
+    speed controller output and to the detection of the resonance frequency
+    from the Iq current.
+ */
+typedef struct
+{
+    /* Notch filters in cascade */
+    NOTCH_FILTER_T filter[NOTCH_FILTER_COUNT];
+    /* Centre frequency of the first notch filter in Hz */
+    int16_t frequency;
+#ifdef NOTCH_ADAPTIVE
+    /* Goertzel coefficients 2*cos(2*pi*f/fs) of the detector, in Q14 */
+    int16_t qCoeff[NOTCH_DETECT_BINS];
+    /* Goertzel state variables, latest and previous */
+    int32_t s1[NOTCH_DETECT_BINS];
+    int32_t s2[NOTCH_DETECT_BINS];
+    /* Power at the detector frequencies of the last block */
+    int32_t power[NOTCH_DETECT_BINS];
+    /* Sum of the Iq samples of the decimation period */
+    int32_t decimationSum;
+    /* Control cycle within the decimation period, also the bin updated */
+    uint16_t decimationCount;
+    /* Decimated Iq without its mean value */
+    int16_t qSample;
+    /* Mean value of the decimated Iq */
+    int16_t qMean;
+    /* State variable for the mean value */
+    int32_t meanStateVar;
+    /* Decimated samples in the current block */
+    uint16_t sampleCount;
+    /* Last detected resonance frequency in Hz, 0 if none */
+    int16_t detectedFrequency;
+#endif
+} NOTCH_PARM_T;
+
+extern NOTCH_PARM_T notchParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitNotchParams(void);
+void NotchReset(void);
+int16_t NotchFilter(int16_t qInput);
+#ifdef NOTCH_ADAPTIVE
+void NotchDetect(int16_t qIq);
+#endif
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NOTCH_H */
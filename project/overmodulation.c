@@ -0,0 +1,273 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file overmodulation.c
+ *
+ * @brief This module extends the space vector modulation from the linear
+ * range into the overmodulation range up to six-step operation.
+ *
+ * Component: OVERMODULATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "overmodulation.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+#include "singleshunt.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* 1.0 in Q14 */
+#define OVERMOD_Q14_ONE     16384
+#ifdef SINGLE_SHUNT
+/* Both active vectors must be longer than the single shunt critical window,
+   as no zero vector time is left to shift the pattern */
+#define OVERMOD_TMIN    (int16_t)(((uint32_t)SSTCRIT << 14)/LOOPTIME_TCY + 1)
+#else
+#define OVERMOD_TMIN    0
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+OVERMOD_PARM_T overmodParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitOvermodulationParams()
+
+  Summary:
+    Initializes overmodulation parameters
+
+  Description:
+    This routine initializes the overmodulation structure variables
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitOvermodulationParams(void)
+{
+    overmodParm.qVoltageAmplitude = 0;
+    overmodParm.qGain = OVERMOD_LINEAR_GAIN;
+    overmodParm.qHold = 0;
+    overmodParm.qTmin = OVERMOD_TMIN;
+    overmodParm.region = OVERMOD_LINEAR;
+}
+// *****************************************************************************
+
+/* Function:
+    OvermodulationLimit()
+
+  Summary:
+    Converts the phase voltages into the modulation range of the space vector
+    modulation
+
+  Description:
+    The voltage base is the six-step fundamental voltage, the linear range of
+    the space vector modulation ends at 0.9069 of it. Two region
+    overmodulation, after Bolognani and Holtz, is used beyond:
+    Region I  - the reference is enlarged and clipped to the hexagon with
+                minimum phase error, the enlargement compensates the voltage
+                lost at the clipped sections.
+    Region II - the vector is held at the hexagon vertices over a fraction of
+                each side that increases with the reference up to six-step
+                at OVERMOD_AMPLITUDE_MAX, the largest amplitude of the
+                current controllers.
+    The phase voltages of the swapped inverse Clarke transform have the
+    property that in every sector the largest magnitude equals T1 + T2 and
+    the other two magnitudes are T1 and T2, so the processing is done
+    without sector identification.
+
+  Precondition:
+    The phase voltages must be calculated with
+    MC_TransformClarkeInverseSwappedInput_Assembly() from pVdq.
+
+  Parameters:
+    pVdq  - pointer to the d-q voltage reference
+    pVabc - pointer to the phase voltages, replaced by the modulation values
+
+  Returns:
+    None.
+
+  Remarks:
+    In single shunt configuration both active vectors are kept longer than
+    the critical measurement window in the overmodulation range, so six-step
+    is approached but not reached.
+ */
+void OvermodulationLimit(const MC_DQ_T *pVdq, MC_ABC_T *pVabc)
+{
+    int32_t squaredAmplitude;
+    int16_t a, b, c, absA, absB, absC, s, factor, sign;
+    int16_t *pMax, *pP, *pQ;
+    int16_t qEdge;
+
+    squaredAmplitude = (__builtin_mulss(pVdq->d, pVdq->d) >> 15) +
+                       (__builtin_mulss(pVdq->q, pVdq->q) >> 15);
+    if (squaredAmplitude > Q15(0.9999))
+    {
+        squaredAmplitude = Q15(0.9999);
+    }
+    overmodParm.qVoltageAmplitude = _Q15sqrt((int16_t)squaredAmplitude);
+
+    if (overmodParm.qVoltageAmplitude <= OVERMOD_LINEAR_LIMIT)
+    {
+        overmodParm.region = OVERMOD_LINEAR;
+        overmodParm.qGain = OVERMOD_LINEAR_GAIN;
+        overmodParm.qHold = 0;
+    }
+    else if (overmodParm.qVoltageAmplitude <= OVERMOD_REGION1_LIMIT)
+    {
+        /* Gain increases linearly from 1 to 1.1 over region I */
+        overmodParm.region = OVERMOD_REGION1;
+        overmodParm.qGain = (int16_t)(__builtin_mulss(OVERMOD_LINEAR_GAIN,
+                16384 + (int16_t)(__builtin_mulss(overmodParm.qVoltageAmplitude
+                - OVERMOD_LINEAR_LIMIT, OVERMOD_REGION1_SLOPE) >> 14)) >> 14);
+        overmodParm.qHold = 0;
+    }
+    else
+    {
+        /* Hold fraction increases linearly from 0 to 0.5 over region II,
+        six-step is reached at the amplitude limit of the current 
+        controllers */
+        overmodParm.region = OVERMOD_REGION2;
+        overmodParm.qGain = (int16_t)(__builtin_mulss(OVERMOD_LINEAR_GAIN,
+                    18022) >> 14);   /* 1.1 in Q14 */
+        overmodParm.qHold = (int16_t)(__builtin_mulss(
+                overmodParm.qVoltageAmplitude - OVERMOD_REGION1_LIMIT,
+                OVERMOD_REGION2_SLOPE) >> 12);
+        if (overmodParm.qHold > (OVERMOD_Q14_ONE >> 1))
+        {
+            overmodParm.qHold = (OVERMOD_Q14_ONE >> 1);
+        }
+    }
+
+    /* Phase voltages in modulation range, Q14 */
+    a = (int16_t)(__builtin_mulss(pVabc->a, overmodParm.qGain) >> 15);
+    b = (int16_t)(__builtin_mulss(pVabc->b, overmodParm.qGain) >> 15);
+    c = (int16_t)(__builtin_mulss(pVabc->c, overmodParm.qGain) >> 15);
+
+    absA = _Q15abs(a);
+    absB = _Q15abs(b);
+    absC = _Q15abs(c);
+    if ((absA >= absB) && (absA >= absC))
+    {
+        pMax = &a;
+        pP = &b;
+        pQ = &c;
+        s = absA;
+    }
+    else if (absB >= absC)
+    {
+        pMax = &b;
+        pP = &c;
+        pQ = &a;
+        s = absB;
+    }
+    else
+    {
+        pMax = &c;
+        pP = &a;
+        pQ = &b;
+        s = absC;
+    }
+
+    if (s > OVERMOD_Q14_ONE)
+    {
+        /* Minimum phase error clipping to the hexagon, T1 + T2 = 1 */
+        factor = __builtin_divf(OVERMOD_Q14_ONE, s);
+        a = (int16_t)(__builtin_mulss(a, factor) >> 15);
+        b = (int16_t)(__builtin_mulss(b, factor) >> 15);
+        c = (int16_t)(__builtin_mulss(c, factor) >> 15);
+        s = _Q15abs(*pMax);
+
+        /* Position along the hexagon side, from the vertex of pP */
+        qEdge = _Q15abs(*pQ);
+        if (qEdge <= overmodParm.qHold)
+        {
+            qEdge = 0;
+        }
+        else if (qEdge >= (s - overmodParm.qHold))
+        {
+            qEdge = s;
+        }
+        else if (overmodParm.qHold > 0)
+        {
+            qEdge = __builtin_divf(qEdge - overmodParm.qHold,
+                                   s - (overmodParm.qHold << 1)) >> 1;
+        }
+        if (qEdge < overmodParm.qTmin)
+        {
+            qEdge = overmodParm.qTmin;
+        }
+        else if (qEdge > (s - overmodParm.qTmin))
+        {
+            qEdge = s - overmodParm.qTmin;
+        }
+
+        /* The two smaller phase voltages have the opposite sign */
+        sign = (*pMax > 0) ? -1 : 1;
+        *pQ = sign * qEdge;
+        *pP = sign * (s - qEdge);
+    }
+
+    /* Back to Q15 */
+    pVabc->a = (a >= OVERMOD_Q14_ONE) ? Q15(0.9999) : (a << 1);
+    pVabc->b = (b >= OVERMOD_Q14_ONE) ? Q15(0.9999) : (b << 1);
+    pVabc->c = (c >= OVERMOD_Q14_ONE) ? Q15(0.9999) : (c << 1);
+}
+
+// </editor-fold>
@@ -0,0 +1,123 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file overmodulation.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the space vector overmodulation stage
+ *
+ * Component: OVERMODULATION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __OVERMODULATION_H
+#define __OVERMODULATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Voltages are fractions of the six-step fundamental voltage */
+/* End of the linear modulation range, pi/(2*sqrt(3)) */
+#define OVERMOD_LINEAR_LIMIT        Q15(0.9069)
+/* End of region I, where the reference follows the hexagon sides */
+#define OVERMOD_REGION1_LIMIT       Q15(0.9517)
+/* Gain from the voltage base to the linear modulation range(1/0.9069), Q14 */
+#define OVERMOD_LINEAR_GAIN         18067
+/* Slope of the region I reference gain over the voltage amplitude,
+   2.2186/4 in Q15 */
+#define OVERMOD_REGION1_SLOPE       18175
+/* Largest voltage amplitude of the current controllers, the square root of
+   MAX_VOLTAGE_VECTOR in pmsm.c, where region II ends in six-step */
+#define OVERMOD_AMPLITUDE_MAX       Q15(0.9899)
+/* Slope of the region II hold fraction over the voltage amplitude, from 0 at
+   OVERMOD_REGION1_LIMIT to 0.5 at OVERMOD_AMPLITUDE_MAX, 13.089/16 in Q15 */
+#define OVERMOD_REGION2_SLOPE       26805
+
+/* Modulation regions */
+typedef enum tagOVERMOD_REGION
+{
+    OVERMOD_LINEAR = 0,         /* Linear space vector modulation */
+    OVERMOD_REGION1 = 1,        /* Reference clipped to the hexagon */
+    OVERMOD_REGION2 = 2         /* Hold at the hexagon vertices */
+} OVERMOD_REGION;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Overmodulation Parameter data type
+
+  Description:
+    This structure will host parameters related to the overmodulation stage.
+ */
+typedef struct
+{
+    /* Amplitude of the voltage reference, fraction of the six-step voltage */
+    int16_t qVoltageAmplitude;
+    /* Gain applied to the reference before clipping, Q14 */
+    int16_t qGain;
+    /* Fraction of the hexagon side held at the vertices, Q14 */
+    int16_t qHold;
+    /* Minimum active vector time in overmodulation, fraction of PWM period
+       in Q14, keeps the single shunt measurement windows open */
+    int16_t qTmin;
+    /* Present modulation region */
+    OVERMOD_REGION region;
+} OVERMOD_PARM_T;
+
+extern OVERMOD_PARM_T overmodParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitOvermodulationParams(void);
+void OvermodulationLimit(const MC_DQ_T *pVdq, MC_ABC_T *pVabc);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OVERMODULATION_H */
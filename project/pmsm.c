@@ -59,6 +59,25 @@
 #include "control.h"   
 #include "estim.h"
 #include "fdweak.h"
+#include "flystart.h"
+#include "ipd.h"
+#include "hfi.h"
+#include "decoupling.h"
+#include "overmodulation.h"
+#include "deadtime.h"
+#include "dpwm.h"
+#include "currentpredict.h"
+#include "dcbuscomp.h"
+#include "speedctrl.h"
+#include "speedramp.h"
+#include "notch.h"
+#include "thermal.h"
+#include "fault.h"
+#include "brake.h"
+#include "mtpa.h"
+#include "efficiency.h"
+#include "meter.h"
+#include "ctrlmode.h"
 
 #include "clock.h"
 #include "pwm.h"
@@ -109,6 +128,15 @@ MCAPP_MEASURE_T measureInputs;
 /* Fraction of dc link voltage(expressed as a squared amplitude) to set 
  * the limit for current controllers PI Output */
 #define MAX_VOLTAGE_VECTOR                      0.98
+#ifdef LOW_SPEED_HFI
+/* Lowest speed reference - the injection estimator controls the motor down 
+   to standstill */
+#define MINIMUMSPEED_ELECTR                     0
+#else
+/* Lowest speed reference - the estimator needs the BEMF of the open loop 
+   end speed */
+#define MINIMUMSPEED_ELECTR                     ENDSPEED_ELECTR
+#endif
 
 // </editor-fold>
 
@@ -156,6 +184,39 @@ int main ( void )
     /* Initialize Peripherals */
     InitPeripherals();
     DiagnosticsInit();
+#ifdef DC_BUS_COMPENSATION
+    /* Initialize DC bus voltage compensation parameters */
+    InitDCBusCompParams();
+#endif
+#ifdef SPEED_GAIN_SCHEDULING
+    /* Initialize speed controller gain scheduling parameters */
+    InitSpeedCtrlParams();
+#endif
+#ifdef RESONANCE_NOTCH_FILTER
+    /* Initialize resonance notch filter parameters */
+    InitNotchParams();
+#endif
+#ifdef THERMAL_PROTECTION
+    /* Initialize the thermal model */
+    InitThermalParams();
+#endif
+#ifdef FAULT_DETECTION
+    /* Initialize the fault detection and reaction */
+    InitFaultParams();
+#endif
+#ifdef CONTROLLED_STOP
+    /* Initialize the controlled stop and the regenerative current limit */
+    InitBrakeParams();
+#endif
+#ifdef POWER_METERING
+    /* Clear the power, torque and energy counters */
+    InitMeterParams();
+#endif
+    /* Request the default control mode with zero torque reference */
+    InitCtrlModeParams();
+    /* Initialize the filters of the potentiometer, bus voltage and 
+    temperature measurements, they run while the motor is stopped */
+    MCAPP_MeasureInit(&measureInputs);
     
     BoardServiceInit();
     CORCONbits.SATA = 0;
@@ -170,14 +231,68 @@ int main ( void )
             DiagnosticsStepMain();
             BoardService();
 
+#ifdef FAULT_DETECTION
+            switch (FaultStepMain())
+            {
+                case FAULT_ACTION_RESET:
+                    /* Motor stopped by a fault */
+                    ResetParmeters();
+                break;
+
+                case FAULT_ACTION_RESTART:
+                    ResetParmeters();
+                    EnablePWMOutputs();
+                    uGF.bits.RunMotor = 1;
+                break;
+
+                default:
+                break;
+            }
+#endif
+#ifdef CONTROLLED_STOP
+            if (BrakeStepMain())
+            {
+                /* Motor stopped by the controlled stop */
+                ResetParmeters();
+            }
+#endif
             if (IsPressed_Button1())
             {
                 if  ((uGF.bits.RunMotor == 1) || (PWM_FAULT_STATUS == 1))
                 {
+#ifdef CONTROLLED_STOP
+                    if ((PWM_FAULT_STATUS == 0) && 
+                        (brakeParm.state == BRAKE_STATE_OFF))
+                    {
+                        /* Decelerate and brake to standstill */
+                        BrakeStart(ctrlParm.qVelRef,
+                                   (uGF.bits.OpenLoop == 0) && 
+                                   (uGF.bits.CatchSpin == 0));
+                    }
+                    else
+#endif
+                    {
+                        ResetParmeters();
+                    }
+                }
+#ifdef CONTROLLED_STOP
+                else if (brakeParm.state != BRAKE_STATE_OFF)
+                {
+                    /* Pressed again during the final stage, coast */
                     ResetParmeters();
                 }
+#endif
+#ifdef FAULT_DETECTION
+                else if (FaultStartAllowed() == 0)
+                {
+                    /* Braking, or DC bus voltage out of range */
+                }
+#endif
                 else
                 {
+#ifdef FAULT_DETECTION
+                    FaultClear();
+#endif
                     EnablePWMOutputs();
                     uGF.bits.RunMotor = 1;
                 }
@@ -254,6 +369,20 @@ void ResetParmeters(void)
     uGF.bits.ChangeSpeed = 0;
     /* Change mode */
     uGF.bits.ChangeMode = 1;
+#ifdef FLYING_START
+    /* Catch a spinning rotor before selecting the start up sequence */
+    uGF.bits.OpenLoop = 0;
+    uGF.bits.CatchSpin = 1;
+#else
+    uGF.bits.CatchSpin = 0;
+#endif
+    uGF.bits.CatchReverse = 0;
+#ifdef INITIAL_POSITION_DETECTION
+    /* Detect the rotor position before the open loop start up */
+    uGF.bits.PositionDetect = 1;
+#else
+    uGF.bits.PositionDetect = 0;
+#endif
     
     /* Initialize PI control parameters */
     InitControlParameters();        
@@ -261,11 +390,72 @@ void ResetParmeters(void)
     InitEstimParm();
     /* Initialize flux weakening parameters */
     InitFWParams();
+#ifdef FLYING_START
+    /* Initialize flying start parameters */
+    InitFlyingStartParams();
+#endif
+#ifdef INITIAL_POSITION_DETECTION
+    /* Initialize initial position detection parameters */
+    InitIPDParams();
+#endif
+#ifdef LOW_SPEED_HFI
+    /* Initialize high frequency injection estimator parameters */
+    InitHFIParams();
+#endif
+#ifdef CURRENT_DECOUPLING
+    /* Initialize current controller feed forward parameters */
+    InitDecouplingParams();
+#endif
+#ifdef OVERMODULATION
+    /* Initialize overmodulation parameters */
+    InitOvermodulationParams();
+#endif
+#ifdef DEADTIME_COMPENSATION
+    /* Initialize dead time compensation parameters */
+    InitDeadTimeParams();
+#endif
+#ifdef DISCONTINUOUS_PWM
+    /* Initialize discontinuous PWM parameters */
+    InitDPWMParams();
+#endif
+#ifdef SINGLE_SHUNT_PREDICTION
+    /* Initialize single shunt current prediction parameters */
+    InitCurrentPredictParams();
+#endif
+#ifdef SPEED_GAIN_SCHEDULING
+    /* Reset the load estimation, the inertia is kept */
+    SpeedCtrlReset(0);
+#endif
+#ifdef SPEED_REF_SCURVE
+    /* Initialize S-curve speed reference parameters */
+    InitSpeedRampParams();
+#endif
+#ifdef RESONANCE_NOTCH_FILTER
+    /* Reset the notch filter states, the frequency is kept */
+    NotchReset();
+#endif
+#ifdef FAULT_DETECTION
+    /* Reset the detectors, the reaction and the bus voltage faults are kept */
+    FaultReset();
+#endif
+#ifdef CONTROLLED_STOP
+    /* End a controlled stop, the regenerative current limit is kept */
+    BrakeReset();
+#endif
+#ifdef MTPA
+    /* Clear the field weakening correction */
+    MtpaReset();
+#endif
+#ifdef EFFICIENCY_OPTIMIZATION
+    /* Remove the d current offset, the search starts again */
+    EfficiencyReset();
+#endif
+    /* Start in speed control, the requested mode is changed to in closed 
+    loop */
+    CtrlModeReset();
     /* Initialize measurement parameters */
     MCAPP_MeasureCurrentInit(&measureInputs);
 
-    MCAPP_MeasureAvgInit(&measureInputs.MOSFETTemperature,
-                                                MOSFET_TEMP_AVG_FILTER_SCALE);
     /* Enable ADC interrupt and begin main loop timing */
     ClearADCIF();
     adcDataBuffer = ClearADCIF_ReadADCBUF();
@@ -298,7 +488,113 @@ void DoControl( void )
 {
     /* Temporary variables for sqrt calculation of q reference */
     volatile int16_t temp_qref_pow_q15;
+    /* Control mode of this control cycle */
+    CTRL_MODE_T controlMode;
+#ifdef CURRENT_DECOUPLING
+    /* Temporary variable for the sum of PI output and feed forward */
+    int32_t tempVoltage;
+#endif
     
+#ifdef FLYING_START
+    if (uGF.bits.CatchSpin)
+    {
+        /* FLYING START: both current components are regulated to zero, so the
+        voltage applied by the current controllers follows the BEMF of the 
+        spinning rotor and the estimator locks to its angle and speed */
+        ctrlParm.qVqRef = 0;
+        ctrlParm.qVdRef = 0;
+
+        /* PI control for D */
+        piInputId.inMeasure = idq.d;
+        piInputId.inReference  = ctrlParm.qVdRef;
+        MC_ControllerPIUpdate_Assembly(piInputId.inReference,
+                                       piInputId.inMeasure,
+                                       &piInputId.piState,
+                                       &piOutputId.out);
+        vdq.d = piOutputId.out;
+        /* Dynamic d-q adjustment
+         with d component priority 
+         vq=sqrt (vs^2 - vd^2) 
+        limit vq maximum to the one resulting from the calculation above */
+        temp_qref_pow_q15 = (int16_t)(__builtin_mulss(piOutputId.out ,
+                                                      piOutputId.out) >> 15);
+        temp_qref_pow_q15 = Q15(MAX_VOLTAGE_VECTOR) - temp_qref_pow_q15;
+        piInputIq.piState.outMax = _Q15sqrt (temp_qref_pow_q15);
+        piInputIq.piState.outMin = - piInputIq.piState.outMax;
+        /* PI control for Q */
+        piInputIq.inMeasure = idq.q;
+        piInputIq.inReference = ctrlParm.qVqRef;
+        MC_ControllerPIUpdate_Assembly(piInputIq.inReference,
+                                       piInputIq.inMeasure,
+                                       &piInputIq.piState,
+                                       &piOutputIq.out);
+        vdq.q = piOutputIq.out;
+
+        switch (FlyingStartDetect(estimator.qVelEstim))
+        {
+            case FLYSTART_FORWARD:
+            case FLYSTART_REVERSE:
+                /* Rotor caught - enter closed loop directly. The speed 
+                reference starts from the estimated speed and the speed 
+                controller from zero torque, the current controllers keep
+                the voltage matching the BEMF */
+                uGF.bits.CatchSpin = 0;
+                uGF.bits.ChangeMode = 0;
+                uGF.bits.PositionDetect = 0;
+#ifndef LOW_SPEED_HFI
+                uGF.bits.CatchReverse = 
+                                (flyStartParm.state == FLYSTART_REVERSE);
+#endif
+                ctrlParm.qVelRef = estimator.qVelEstim;
+                ctrlParm.speedRampCount = 0;
+                piInputOmega.piState.integrator = 0;
+                estimator.qRhoOffset = 0;
+            break;
+
+            case FLYSTART_STANDSTILL:
+                /* Rotor too slow to be caught - continue with the open loop
+                lock and ramp start up sequence */
+                uGF.bits.CatchSpin = 0;
+                uGF.bits.OpenLoop = 1;
+                uGF.bits.ChangeMode = 1;
+                piInputId.piState.integrator = 0;
+                piInputIq.piState.integrator = 0;
+            break;
+
+            default:
+            break;
+        }
+    }
+    else
+#endif
+#ifdef INITIAL_POSITION_DETECTION
+    if (uGF.bits.PositionDetect)
+    {
+        /* INITIAL POSITION DETECTION: voltage pulses are applied on the d-axis
+        at the test angle, the current controllers are bypassed */
+        if (IPDStep(idq.d))
+        {
+            /* Seed the open loop and estimator angles with the detected
+            rotor angle and continue with the open loop ramp */
+            uGF.bits.PositionDetect = 0;
+#ifdef LOW_SPEED_HFI
+            /* The injection estimator tracks the rotor from standstill -
+            start directly in closed loop */
+            uGF.bits.OpenLoop = 0;
+            HFISync(ipdParm.qRotorAngle, 0);
+#else
+            uGF.bits.OpenLoop = 1;
+#endif
+            uGF.bits.ChangeMode = 1;
+            thetaElectricalOpenLoop = ipdParm.qRotorAngle;
+            estimator.qRho = ipdParm.qRotorAngle;
+            estimator.qRhoStateVar = (int32_t)ipdParm.qRotorAngle << 15;
+        }
+        vdq.d = ipdParm.qVdInject;
+        vdq.q = 0;
+    }
+    else
+#endif
     if  (uGF.bits.OpenLoop)
     {
         /* OPENLOOP:  force rotating angle,Vd and Vq */
@@ -315,6 +611,13 @@ void DoControl( void )
             /* Reinitialize variables for initial speed ramp */
             motorStartUpData.startupLock = 0;
             motorStartUpData.startupRamp = 0;
+            #ifdef INITIAL_POSITION_DETECTION
+                /* Rotor angle is known - skip the lock sequence */
+                if (ipdParm.done)
+                {
+                    motorStartUpData.startupLock = LOCK_TIME;
+                }
+            #endif
             #ifdef TUNING
                 motorStartUpData.tuningAddRampup = 0;
                 motorStartUpData.tuningDelayRampup = 0;
@@ -371,14 +674,34 @@ void DoControl( void )
         else
         {
 
-            /* Potentiometer value is scaled between ENDSPEED_ELECTR 
+            /* Potentiometer value is scaled between MINIMUMSPEED_ELECTR 
              * and NOMINALSPEED_ELECTR to set the speed reference*/
             
             ctrlParm.targetSpeed = (__builtin_mulss(measureInputs.potValueScaled,
-                    NOMINALSPEED_ELECTR-ENDSPEED_ELECTR)>>15) +
-                    ENDSPEED_ELECTR;  
+                    NOMINALSPEED_ELECTR-MINIMUMSPEED_ELECTR)>>15) +
+                    MINIMUMSPEED_ELECTR;  
             
         }
+#ifdef FLYING_START
+        if (uGF.bits.CatchReverse)
+        {
+            /* Rotor caught in reverse - decelerate it in closed loop down to
+            the minimum catch speed, then let it coast with zero current and
+            catch it again */
+            ctrlParm.targetSpeed = -flyStartParm.qMinCatchSpeed;
+            if (ctrlParm.qVelRef >= ctrlParm.targetSpeed)
+            {
+                uGF.bits.CatchReverse = 0;
+                uGF.bits.CatchSpin = 1;
+                FlyingStartCoast();
+            }
+        }
+#endif
+#ifdef SPEED_REF_SCURVE
+        /* Jerk limited speed reference */
+        ctrlParm.qVelRef = SpeedRampUpdate(ctrlParm.qVelRef,
+                                           ctrlParm.targetSpeed);
+#else
         if  (ctrlParm.speedRampCount < SPEEDREFRAMP_COUNT)
         {
            ctrlParm.speedRampCount++; 
@@ -408,6 +731,7 @@ void DoControl( void )
             }
             ctrlParm.speedRampCount = 0;
         }
+#endif
         /* Tuning is generating a software ramp
         with sufficiently slow ramp defined by 
         TUNING_DELAY_RAMPUP constant */
@@ -428,28 +752,126 @@ void DoControl( void )
             /* The reference is continued from the open loop speed up ramp */
             ctrlParm.qVelRef = ENDSPEED_ELECTR +  motorStartUpData.tuningAddRampup;
         #endif
+#ifdef CONTROLLED_STOP
+        if (brakeParm.state == BRAKE_STATE_DECEL)
+        {
+            /* The stop ramp replaces the speed reference */
+            ctrlParm.qVelRef = BrakeSpeedRef(estimator.qVelEstim);
+        }
+#endif
 
         if (uGF.bits.ChangeMode)
         {
             /* Just changed from open loop */
             uGF.bits.ChangeMode = 0;
             piInputOmega.piState.integrator = (int32_t)ctrlParm.qVqRef << 13;
-            ctrlParm.qVelRef = ENDSPEED_ELECTR;
+            ctrlParm.qVelRef = MINIMUMSPEED_ELECTR;
+#ifdef SPEED_GAIN_SCHEDULING
+            SpeedCtrlReset(ctrlParm.qVelRef);
+#endif
         }
 
-        /* If TORQUE MODE skip the speed controller */
-        #ifndef	TORQUE_MODE
-            /* Execute the velocity control loop */
+        /* The stop ramp and the catch of a reverse spinning rotor need the
+        speed controller */
+        controlMode = ctrlModeParm.request;
+#ifdef CONTROLLED_STOP
+        if (brakeParm.state != BRAKE_STATE_OFF)
+        {
+            controlMode = CTRL_MODE_SPEED;
+        }
+#endif
+#ifdef FLYING_START
+        if (uGF.bits.CatchReverse)
+        {
+            controlMode = CTRL_MODE_SPEED;
+        }
+#endif
+        CtrlModeSelect(controlMode, &piInputOmega.piState, ctrlParm.qVqRef);
+
+        #ifdef LOW_SPEED_HFI
+            piInputOmega.inMeasure = hfiParm.qVel;
+        #else
             piInputOmega.inMeasure = estimator.qVelEstim;
+        #endif
+        if (ctrlModeParm.mode == CTRL_MODE_TORQUE)
+        {
+            /* Torque control skips the speed controller, the speed 
+            reference follows the speed for the change to speed control */
+            ctrlParm.qVelRef = piInputOmega.inMeasure;
+            ctrlParm.qVqRef = CtrlModeTorque();
+        }
+        else
+        {
+            /* Execute the velocity control loop */
             piInputOmega.inReference = ctrlParm.qVelRef;
+            piInputOmega.piState.outMax = SPEEDCNTR_OUTMAX;
+            piInputOmega.piState.outMin = -piInputOmega.piState.outMax;
+#ifdef THERMAL_PROTECTION
+            /* Speed controller output within the thermal current limit */
+            piInputOmega.piState.outMax = thermalParm.qIqLimit;
+            piInputOmega.piState.outMin = -thermalParm.qIqLimit;
+#endif
+#ifdef CONTROLLED_STOP
+            /* Regenerative output limited by the DC bus voltage */
+            BrakeRegenLimitPI(&piInputOmega.piState, piInputOmega.inMeasure);
+#endif
+            if (ctrlModeParm.mode == CTRL_MODE_SPEED_LIMITED_TORQUE)
+            {
+                /* Speed controller output limited to the torque reference, 
+                it reduces the torque at the speed limit */
+                CtrlModeTorque();
+                piInputOmega.inReference = 
+                        CtrlModeSpeedLimit(ctrlParm.qVelRef);
+                CtrlModeLimitPI(&piInputOmega.piState);
+            }
+#ifdef SPEED_GAIN_SCHEDULING
+            /* Gains for the present speed and load inertia */
+            SpeedCtrlSchedule(piInputOmega.inReference,
+                              piInputOmega.inMeasure,
+                              &piInputOmega.piState);
+#endif
             MC_ControllerPIUpdate_Assembly(piInputOmega.inReference,
                                            piInputOmega.inMeasure,
                                            &piInputOmega.piState,
                                            &piOutputOmega.out);
+#ifdef RESONANCE_NOTCH_FILTER
+            ISR_CYCLES_STAGE(speed);
+#ifdef NOTCH_ADAPTIVE
+            /* Tune the notch to the resonance found in Iq */
+            NotchDetect(idq.q);
+#endif
+            /* Remove the resonance frequency from the speed controller 
+            output */
+            piOutputOmega.out = NotchFilter(piOutputOmega.out);
+            ISR_CYCLES_STAGE(notch);
+#endif
             ctrlParm.qVqRef = piOutputOmega.out;
-        #else
-            ctrlParm.qVqRef = ctrlParm.qVelRef;
-        #endif
+#ifdef SPEED_GAIN_SCHEDULING
+            if (ctrlModeParm.mode == CTRL_MODE_SPEED)
+            {
+                /* Acceleration of the reference ramp fed forward */
+                ctrlParm.qVqRef = SpeedCtrlFeedForward(piOutputOmega.out);
+            }
+#endif
+#ifdef SPEED_RAMP_TIME_OPTIMAL
+            /* Acceleration limits follow the current headroom */
+            SpeedRampAdapt(ctrlParm.qVqRef);
+#endif
+        }
+#ifdef DC_LINK_RIPPLE_SHAPING
+        /* Motor power follows the rectified mains voltage, regeneration is
+        limited by BrakeRegenLimit() */
+        ctrlParm.qVqRef = DCBusRippleShape(ctrlParm.qVqRef,
+                                           estimator.qVelEstim);
+#endif
+#ifdef THERMAL_PROTECTION
+        /* Feed forward, shaping and torque mode references are limited too */
+        ctrlParm.qVqRef = ThermalLimit(ctrlParm.qVqRef);
+#endif
+#ifdef CONTROLLED_STOP
+        ctrlParm.qVqRef = BrakeRegenLimit(ctrlParm.qVqRef, 
+                                          estimator.qVelEstim);
+#endif
         
         /* Flux weakening control - the actual speed is replaced 
         with the reference speed for stability 
@@ -460,7 +882,54 @@ void DoControl( void )
         re-calculated for the specific motor. The maximum speed of 5000rpm is 
         achieved from the 310VDC bus voltage* */
         ctrlParm.qVdRef= 0 ; /* Not calling the table based FW functions*/
+#ifdef MTPA
+        /* MTPA d current, field weakening at the voltage limit and the q 
+        current within the current limit */
+        ctrlParm.qVqRef = MtpaCurrentRef(ctrlParm.qVqRef, &vdq);
+        ctrlParm.qVdRef = mtpaParm.qIdRef;
+#endif
+#ifdef EFFICIENCY_OPTIMIZATION
+        if (ctrlModeParm.mode == CTRL_MODE_SPEED)
+        {
+            /* d current offset with the lowest input power at light load,
+            the shaft power is constant only at constant speed */
+            ctrlParm.qVdRef += EfficiencySearch(ctrlParm.qVelRef, 
+                                                ctrlParm.qVqRef, &vdq, &idq);
+        }
+        else
+        {
+            EfficiencyReset();
+        }
+#endif
+#ifdef CONTROLLED_STOP
+        if (brakeParm.state == BRAKE_STATE_DC_INJECTION)
+        {
+            /* DC current at the angle held by BrakeAngle() */
+            ctrlParm.qVdRef = BRAKE_DC_CURRENT_REF;
+            ctrlParm.qVqRef = 0;
+        }
+#endif
 
+#ifdef CURRENT_DECOUPLING
+        /* Cross coupling and BEMF voltages are fed forward, the current 
+        controllers only correct the remaining error */
+        DecouplingCalculate(estimator.qVelEstim, &idq);
+        /* The d controller output range is shifted by the feed forward as
+        for q, so that the integrator does not wind up against the voltage
+        limit of the sum */
+        tempVoltage = (int32_t)Q15(MAX_VOLTAGE_VECTOR) - decouplingParm.qVdFF;
+        if (tempVoltage > Q15(0.9999))
+        {
+            tempVoltage = Q15(0.9999);
+        }
+        piInputId.piState.outMax = (int16_t)tempVoltage;
+        tempVoltage = -(int32_t)Q15(MAX_VOLTAGE_VECTOR) - decouplingParm.qVdFF;
+        if (tempVoltage < -Q15(0.9999))
+        {
+            tempVoltage = -Q15(0.9999);
+        }
+        piInputId.piState.outMin = (int16_t)tempVoltage;
+#endif
         /* PI control for D */
         piInputId.inMeasure = idq.d;
         piInputId.inReference  = ctrlParm.qVdRef;
@@ -468,17 +937,46 @@ void DoControl( void )
                                        piInputId.inMeasure,
                                        &piInputId.piState,
                                        &piOutputId.out);
+#ifdef CURRENT_DECOUPLING
+        tempVoltage = (int32_t)piOutputId.out + decouplingParm.qVdFF;
+        if (tempVoltage > Q15(MAX_VOLTAGE_VECTOR))
+        {
+            tempVoltage = Q15(MAX_VOLTAGE_VECTOR);
+        }
+        else if (tempVoltage < -Q15(MAX_VOLTAGE_VECTOR))
+        {
+            tempVoltage = -Q15(MAX_VOLTAGE_VECTOR);
+        }
+        vdq.d = (int16_t)tempVoltage;
+#else
         vdq.d    = piOutputId.out;
+#endif
 
         /* Dynamic d-q adjustment
          with d component priority 
          vq=sqrt (vs^2 - vd^2) 
         limit vq maximum to the one resulting from the calculation above */
-        temp_qref_pow_q15 = (int16_t)(__builtin_mulss(piOutputId.out ,
-                                                      piOutputId.out) >> 15);
+        temp_qref_pow_q15 = (int16_t)(__builtin_mulss(vdq.d ,
+                                                      vdq.d) >> 15);
         temp_qref_pow_q15 = Q15(MAX_VOLTAGE_VECTOR) - temp_qref_pow_q15;
         piInputIq.piState.outMax = _Q15sqrt (temp_qref_pow_q15);
         piInputIq.piState.outMin = - piInputIq.piState.outMax;
+#ifdef CURRENT_DECOUPLING
+        /* The q controller output range is shifted by the feed forward, so 
+        that the sum stays within the voltage limit */
+        tempVoltage = (int32_t)piInputIq.piState.outMax - decouplingParm.qVqFF;
+        if (tempVoltage > Q15(0.9999))
+        {
+            tempVoltage = Q15(0.9999);
+        }
+        piInputIq.piState.outMax = (int16_t)tempVoltage;
+        tempVoltage = (int32_t)piInputIq.piState.outMin - decouplingParm.qVqFF;
+        if (tempVoltage < -Q15(0.9999))
+        {
+            tempVoltage = -Q15(0.9999);
+        }
+        piInputIq.piState.outMin = (int16_t)tempVoltage;
+#endif
 
         /* PI control for Q */
         piInputIq.inMeasure  = idq.q;
@@ -487,7 +985,11 @@ void DoControl( void )
                                        piInputIq.inMeasure,
                                        &piInputIq.piState,
                                        &piOutputIq.out);
+#ifdef CURRENT_DECOUPLING
+        vdq.q = piOutputIq.out + decouplingParm.qVqFF;
+#else
         vdq.q = piOutputIq.out;
+#endif
     }
       
 }
@@ -517,6 +1019,7 @@ void DoControl( void )
  */
 void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
 {
+    ISR_CYCLES_START();
 #ifdef SINGLE_SHUNT 
     if (IFS4bits.PWM1IF ==1)
     {
@@ -554,6 +1057,14 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
         default:
         break;  
     }
+#endif
+#ifdef DC_BUS_COMPENSATION
+    if (singleShuntParam.adcSamplePoint == 0)
+    {
+        /* Bus voltage sampled with the phase currents, used by the control
+        of this cycle */
+        DCBusCompUpdate(ADCBUF_VBUS_A);
+    }
 #endif
     /*If motor run command is ON*/
     if (uGF.bits.RunMotor)
@@ -564,11 +1075,24 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
              
 #ifdef SINGLE_SHUNT
                 
+#ifdef SINGLE_SHUNT_PREDICTION
+            /* Predict the currents with the voltage applied in last cycle */
+            CurrentPredict(&currentPredictParm.valphabeta,&bemfAlphaBeta);
+#endif
             /* Reconstruct Phase currents from Bus Current*/                
             SingleShunt_PhaseCurrentReconstruction(&singleShuntParam);
+#ifdef SINGLE_SHUNT_PREDICTION
+            /* Replace the unsettled samples by the prediction */
+            CurrentPredictBlend(&singleShuntParam);
+#endif
             iabc.a = singleShuntParam.Ia;
             iabc.b = singleShuntParam.Ib;
+#ifdef POWER_METERING
+            /* Mean bus current, before T1 and T2 are recalculated */
+            MeterBusCurrent(&singleShuntParam);
+#endif
 #else
+            WaitADCOversampling();
             measureInputs.current.Ia = ADCBUF_INV_A_IPHASE1;
             measureInputs.current.Ib = ADCBUF_INV_A_IPHASE2;
             MCAPP_MeasureCurrentCalibrate(&measureInputs);
@@ -578,11 +1102,49 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
             /* Calculate qId,qIq from qSin,qCos,qIa,qIb */
             MC_TransformClarke_Assembly(&iabc,&ialphabeta);
             MC_TransformPark_Assembly(&ialphabeta,&sincosTheta,&idq);
+#ifdef THERMAL_PROTECTION
+            ThermalAccumulate(&idq);
+#endif
+#ifdef FAULT_DETECTION
+            /* The phase currents are compared only when the speed is known */
+            FaultDetectCurrent(&iabc, (uGF.bits.OpenLoop == 0) ?
+                                        estimator.qVelEstim : 0);
+#endif
+            ISR_CYCLES_STAGE(current);
 
             /* Speed and field angle estimation */
             Estim();
+            ISR_CYCLES_STAGE(estim);
+#ifdef LOW_SPEED_HFI
+            /* Remove the injection response from the control currents */
+            HFIDemodulate(&idq);
+            if ((uGF.bits.OpenLoop == 0) && (uGF.bits.CatchSpin == 0))
+            {
+                /* Track the angle and blend it with the estimator */
+                HFIEstimate(estimator.qRho + estimator.qRhoOffset,
+                            estimator.qVelEstim);
+            }
+            else
+            {
+                /* No injection, follow the estimator */
+                HFISync(estimator.qRho + estimator.qRhoOffset,
+                        estimator.qVelEstim);
+            }
+            ISR_CYCLES_STAGE(hfi);
+#endif
             /* Calculate control values */
             DoControl();
+#ifdef FAULT_DETECTION
+            if ((uGF.bits.OpenLoop == 0) && (uGF.bits.CatchSpin == 0) &&
+                (ctrlModeParm.mode == CTRL_MODE_SPEED))
+            {
+                /* Speed controller at its limit without the rotor following */
+                FaultDetectStall(estimator.qVelEstim, estimator.qEsdf,
+                        estimator.qEsqf,
+                        (piOutputOmega.out >= piInputOmega.piState.outMax) ||
+                        (piOutputOmega.out <= piInputOmega.piState.outMin));
+            }
+#endif
             /* Calculate qAngle */
             CalculateParkAngle();
             /* if open loop */
@@ -593,25 +1155,72 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
             }
             else
             {
+#ifdef LOW_SPEED_HFI
+                /* if closed loop, angle generated by the injection estimator
+                blended with the estimator */
+                thetaElectrical = hfiParm.qRho;
+#else
                 /* if closed loop, angle generated by estimator */
                 thetaElectrical = estimator.qRho + estimator.qRhoOffset;
+#endif
             }
+#ifdef CONTROLLED_STOP
+            /* Angle held during the DC injection */
+            thetaElectrical = BrakeAngle(thetaElectrical);
+#endif
+#ifdef LOW_SPEED_HFI
+            /* Superimpose the injection on the d-axis voltage */
+            HFIInject(&vdq);
+#endif
+            ISR_CYCLES_STAGE(control);
             MC_CalculateSineCosine_Assembly_Ram(thetaElectrical,&sincosTheta);
             MC_TransformParkInverse_Assembly(&vdq,&sincosTheta,&valphabeta);
-            
-            CompensateDCBusVoltage(&vabc,&measureInputs);
-
+#ifdef DC_BUS_COMPENSATION
+            /* Scale the modulator input with the reciprocal of the bus 
+            voltage, valphabeta remains the estimator input */
+            DCBusCompensate(&valphabeta,&dcBusCompParm.valphabeta);
+            MC_TransformClarkeInverseSwappedInput_Assembly(
+                    &dcBusCompParm.valphabeta,&vabc);
+#else
             MC_TransformClarkeInverseSwappedInput_Assembly(&valphabeta,&vabc);
+#endif
+#ifdef DEADTIME_COMPENSATION
+            /* Add the inverter voltage error in the direction of the phase 
+            currents */
+            DeadTimeCompensate(&iabc,&vabc);
+#endif
+#ifdef OVERMODULATION
+            /* Scale the voltages to the modulation range and extend it 
+            beyond the linear range */
+            OvermodulationLimit(&vdq,&vabc);
+#endif
+#ifdef DISCONTINUOUS_PWM
+            DPWMSelectMode(&vdq);
+#endif
                 
 #ifdef  SINGLE_SHUNT
             SingleShunt_CalculateSpaceVectorPhaseShifted(&vabc,pwmPeriod,&singleShuntParam);
+#ifdef DISCONTINUOUS_PWM
+            /* Clamp one leg by shifting the whole pattern with its triggers */
+            SingleShunt_ShiftPattern(&singleShuntParam,
+                    DPWMCalculateOffset(&singleShuntParam.pwmDutycycle1,
+                            &singleShuntParam.pwmDutycycle2,pwmPeriod));
+#endif
 
             PWMDutyCycleSetDualEdge(&singleShuntParam.pwmDutycycle1,&singleShuntParam.pwmDutycycle2);
+#ifdef SINGLE_SHUNT_PREDICTION
+            /* Voltage of the limited duty cycles, predicts the next cycle */
+            CurrentPredictVoltage(&singleShuntParam);
+#endif
 #else
             MC_CalculateSpaceVectorPhaseShifted_Assembly(&vabc,pwmPeriod,
                                                         &pwmDutycycle);
+#ifdef DISCONTINUOUS_PWM
+            DPWMClamp(&pwmDutycycle,pwmPeriod);
+#endif
             PWMDutyCycleSet(&pwmDutycycle);
 #endif
+            ISR_CYCLES_STAGE(modulation);
                 
         }
     }
@@ -643,10 +1252,37 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
     {
         if (uGF.bits.RunMotor == 0)
         {
+            WaitADCOversampling();
             measureInputs.current.Ia = ADCBUF_INV_A_IPHASE1;
             measureInputs.current.Ib = ADCBUF_INV_A_IPHASE2; 
             measureInputs.current.Ibus = ADCBUF_INV_A_IBUS; 
+#ifdef CURRENT_OFFSET_TRACKING
+            /* No current flows while the PWM outputs are disabled and the 
+            rotor is at standstill, the samples are the offsets. While 
+            braking the outputs are enabled */
+            if (IsEnabled_PWMOutputs() == false)
+            {
+                MCAPP_MeasureCurrentOffsetTrack(&measureInputs);
+            }
+            else
+            {
+                MCAPP_MeasureCurrentOffsetHold(&measureInputs);
+            }
+#endif
+        }
+#ifdef CURRENT_OFFSET_TRACKING
+        else
+        {
+            /* The rotor coasts after the outputs are disabled */
+            MCAPP_MeasureCurrentOffsetHold(&measureInputs);
         }
+#endif
+#ifdef CURRENT_OFFSET_TRACKING
+        if (MCAPP_MeasureCurrentOffsetStatus(&measureInputs) != 0)
+        {
+            BoardServiceStepIsr(); 
+        }
+#else
         if (MCAPP_MeasureCurrentOffsetStatus(&measureInputs) == 0)
         {
             MCAPP_MeasureCurrentOffset(&measureInputs);
@@ -655,14 +1291,45 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
         {
             BoardServiceStepIsr(); 
         }
-        measureInputs.potValue = (int16_t)( ADCBUF_SPEED_REF_A>>1);
+#endif
+        MCAPP_MeasurePot(&measureInputs,(int16_t)( ADCBUF_SPEED_REF_A>>1));
         SaturateAndScalePOTvalue(&measureInputs);
         
-        measureInputs.dcBusVoltage = (int16_t)( ADCBUF_VBUS_A>>1);
+        MCAPP_MeasureDCBusVoltage(&measureInputs,(int16_t)( ADCBUF_VBUS_A>>1));
         
         MCAPP_MeasureTemperature(&measureInputs,(int16_t)(ADCBUF_MOSFET_TEMP_A>>1));
+#ifdef THERMAL_PROTECTION
+        /* Thermal model and current limit from the heatsink temperature */
+        ThermalStepIsr(measureInputs.MOSFETTemperatureAvg);
+#endif
+#ifdef CONTROLLED_STOP
+        /* Bus voltage without the delay of the low pass filter, the limit 
+        must follow the voltage rise of the braking energy */
+        if (BrakeStepIsr(measureInputs.dcBusVoltageMedian.output))
+        {
+            /* Short circuit brake, the PWM outputs stay enabled */
+            uGF.bits.RunMotor = 0;
+        }
+#ifdef BRAKE_CHOPPER
+        BRAKE_CHOPPER_OUTPUT = brakeParm.chopper;
+#endif
+#endif
+#ifdef FAULT_DETECTION
+        FaultDetectVoltage(measureInputs.dcBusVoltageMedian.output);
+        if (FaultStepIsr(uGF.bits.RunMotor))
+        {
+            /* Stop the motor, the PWM outputs are disabled or brake */
+            uGF.bits.RunMotor = 0;
+        }
+#endif
+#ifdef POWER_METERING
+        MeterStepIsr(uGF.bits.RunMotor, &vdq, &idq,
+                     measureInputs.dcBusVoltageMedian.output);
+#endif
         
         DiagnosticsStepIsr();
+        ISR_CYCLES_STAGE(service);
+        ISR_CYCLES_END();
     }
     /* Read ADC Buffet to Clear Flag */
 	adcDataBuffer = ClearADCIF_ReadADCBUF();
@@ -693,8 +1360,16 @@ void __attribute__((__interrupt__,no_auto_psv)) _ADCInterrupt()
  */
 void CalculateParkAngle(void)
 {
+    /* if initial position detection */
+    if (uGF.bits.PositionDetect)
+    {
+        /* the angle is given by the test angle of the detection */
+        #ifdef INITIAL_POSITION_DETECTION
+            thetaElectricalOpenLoop = ipdParm.qTestAngle;
+        #endif
+    }
     /* if open loop */
-    if (uGF.bits.OpenLoop)
+    else if (uGF.bits.OpenLoop)
     {
         /* begin with the lock sequence, for field alignment */
         if (motorStartUpData.startupLock < LOCK_TIME)
@@ -797,6 +1472,10 @@ void InitControlParameters(void)
 void __attribute__((__interrupt__,no_auto_psv)) _PWMInterrupt()
 {
     ResetParmeters();
+#ifdef FAULT_DETECTION
+    /* The restart policy applies to the comparator trip */
+    FaultHardwareTrip();
+#endif
     ClearPWMPCIFault();
     ClearPWMIF(); 
 }
@@ -0,0 +1,385 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file restart.c
+ *
+ * @brief This module implements the restart policy after fault trips, with
+ * restart rules for each fault class, exponential backoff of the restart
+ * delay and a lockout after repeated trips.
+ *
+ * Component: FAULT DETECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+
+#include "restart.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Control cycles per second */
+#define RESTART_SECOND_COUNT    (uint16_t)(1.0/LOOPTIME_SEC)
+/* Times in control cycles */
+#define RESTART_DELAY_COUNT(sec) (uint32_t)((sec)/LOOPTIME_SEC)
+#define RESTART_DELAY_MAX       RESTART_DELAY_COUNT(FAULT_RESTART_DELAY_MAX_SEC)
+#define RESTART_RUN_COUNT       RESTART_DELAY_COUNT(FAULT_RESTART_CLEAR_SEC)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+RESTART_PARM_T restartParm;
+
+/* Restart rules, in the order of the fault classes */
+static const RESTART_RULE_T restartRule[FAULT_CLASS_COUNT] =
+{
+    {FAULT_OVERCURRENT_RESTARTS,
+            RESTART_DELAY_COUNT(FAULT_OVERCURRENT_RESTART_SEC)},
+    {FAULT_STALL_RESTARTS,
+            RESTART_DELAY_COUNT(FAULT_STALL_RESTART_SEC)},
+    {FAULT_PHASE_LOSS_RESTARTS,
+            RESTART_DELAY_COUNT(FAULT_PHASE_LOSS_RESTART_SEC)},
+    {FAULT_OVERVOLTAGE_RESTARTS,
+            RESTART_DELAY_COUNT(FAULT_OVERVOLTAGE_RESTART_SEC)},
+    {FAULT_UNDERVOLTAGE_RESTARTS,
+            RESTART_DELAY_COUNT(FAULT_UNDERVOLTAGE_RESTART_SEC)},
+    {FAULT_HARDWARE_RESTARTS,
+            RESTART_DELAY_COUNT(FAULT_HARDWARE_RESTART_SEC)}
+};
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static uint16_t RestartCheckLockout(void);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitRestartParams()
+
+  Summary:
+    Initializes restart policy parameters
+
+  Description:
+    This routine clears the trip, restart and lockout counters, the trip
+    times and the time base.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the counters are kept until the next power up.
+ */
+void InitRestartParams(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < FAULT_CLASS_COUNT; i++)
+    {
+        restartParm.tripCount[i] = 0;
+        restartParm.consecutive[i] = 0;
+    }
+    for (i = 0; i < FAULT_LOCKOUT_TRIPS; i++)
+    {
+        restartParm.tripTime[i] = 0;
+    }
+    restartParm.restartTotal = 0;
+    restartParm.lockoutTotal = 0;
+    restartParm.lockout = 0;
+    restartParm.runCount = 0;
+    restartParm.seconds = 0;
+    restartParm.secondCount = 0;
+    restartParm.tripIndex = 0;
+    restartParm.tripStored = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    RestartStepIsr()
+
+  Summary:
+    Updates the time base and the fault free running time
+
+  Description:
+    The time since power up is counted in seconds for the lockout window.
+    After FAULT_RESTART_CLEAR_SEC of running without faults the consecutive
+    restarts of all fault classes are cleared.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    running - nonzero if the motor runs without faults
+
+  Returns:
+    None.
+
+  Remarks:
+    The seconds counter wraps after 136 years.
+ */
+void RestartStepIsr(uint16_t running)
+{
+    uint16_t i;
+
+    restartParm.secondCount++;
+    if (restartParm.secondCount >= RESTART_SECOND_COUNT)
+    {
+        restartParm.secondCount = 0;
+        restartParm.seconds++;
+    }
+
+    if (running == 0)
+    {
+        return;
+    }
+    if (restartParm.runCount < RESTART_RUN_COUNT)
+    {
+        restartParm.runCount++;
+        if (restartParm.runCount == RESTART_RUN_COUNT)
+        {
+            for (i = 0; i < FAULT_CLASS_COUNT; i++)
+            {
+                restartParm.consecutive[i] = 0;
+            }
+        }
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    RestartPolicy()
+
+  Summary:
+    Records a trip and decides whether the motor is restarted
+
+  Description:
+    The trip is counted for its fault class and its time is stored. The
+    drive is locked out if this is the FAULT_LOCKOUT_TRIPS-th trip within
+    FAULT_LOCKOUT_WINDOW_SEC, whatever the fault classes.
+    Otherwise the motor is restarted if the consecutive restarts of the
+    fault class are fewer than the restarts of its rule. The delay of the
+    rule is multiplied by 2^FAULT_RESTART_BACKOFF_SHIFT for every
+    consecutive restart, up to FAULT_RESTART_DELAY_MAX_SEC.
+
+  Precondition:
+    Called once for every trip, after the motor was stopped.
+
+  Parameters:
+    faultClass - class of the fault that stopped the motor
+
+  Returns:
+    Restart delay in control cycles, 0 if the fault is latched.
+
+  Remarks:
+    None.
+ */
+uint32_t RestartPolicy(uint16_t faultClass)
+{
+    uint32_t delay;
+    uint16_t i;
+
+    restartParm.runCount = 0;
+    if (restartParm.tripCount[faultClass] < UINT16_MAX)
+    {
+        restartParm.tripCount[faultClass]++;
+    }
+
+    if (RestartCheckLockout())
+    {
+        restartParm.lockout = 1;
+        if (restartParm.lockoutTotal < UINT16_MAX)
+        {
+            restartParm.lockoutTotal++;
+        }
+    }
+    if ((restartParm.lockout != 0) ||
+        (restartParm.consecutive[faultClass] >=
+                                        restartRule[faultClass].restarts))
+    {
+        return 0;
+    }
+
+    delay = restartRule[faultClass].delayCount;
+    for (i = 0; i < restartParm.consecutive[faultClass]*
+                                        FAULT_RESTART_BACKOFF_SHIFT; i++)
+    {
+        delay <<= 1;
+        if (delay >= RESTART_DELAY_MAX)
+        {
+            delay = RESTART_DELAY_MAX;
+            break;
+        }
+    }
+    restartParm.consecutive[faultClass]++;
+    return delay;
+}
+// *****************************************************************************
+
+/* Function:
+    RestartExecuted()
+
+  Summary:
+    Counts an automatic restart
+
+  Description:
+    The restart total is incremented when the motor is started again after
+    the restart delay.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void RestartExecuted(void)
+{
+    if (restartParm.restartTotal < UINT16_MAX)
+    {
+        restartParm.restartTotal++;
+    }
+}
+// *****************************************************************************
+
+/* Function:
+    RestartClear()
+
+  Summary:
+    Clears the lockout and the consecutive restarts
+
+  Description:
+    Called when the motor is started by the user, a latched fault or a
+    lockout is acknowledged and the restart rules apply again in full.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    The trip times are kept, a further trip within the lockout window locks
+    the drive out again.
+ */
+void RestartClear(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < FAULT_CLASS_COUNT; i++)
+    {
+        restartParm.consecutive[i] = 0;
+    }
+    restartParm.lockout = 0;
+    restartParm.runCount = 0;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    RestartCheckLockout()
+
+  Summary:
+    Stores the trip time and checks the trips within the lockout window
+
+  Description:
+    The time of the trip replaces the oldest of the last FAULT_LOCKOUT_TRIPS
+    trip times. If all of them are within FAULT_LOCKOUT_WINDOW_SEC of the
+    trip, the drive is locked out.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    Nonzero if the drive is locked out.
+
+  Remarks:
+    None.
+ */
+static uint16_t RestartCheckLockout(void)
+{
+    restartParm.tripTime[restartParm.tripIndex] = restartParm.seconds;
+    restartParm.tripIndex++;
+    if (restartParm.tripIndex >= FAULT_LOCKOUT_TRIPS)
+    {
+        restartParm.tripIndex = 0;
+    }
+    if (restartParm.tripStored < FAULT_LOCKOUT_TRIPS)
+    {
+        restartParm.tripStored++;
+    }
+    /* The oldest stored trip time is FAULT_LOCKOUT_TRIPS - 1 trips before
+       this one */
+    if ((restartParm.tripStored >= FAULT_LOCKOUT_TRIPS) &&
+        (restartParm.seconds -
+                restartParm.tripTime[restartParm.tripIndex] <
+                                                    FAULT_LOCKOUT_WINDOW_SEC))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+// </editor-fold>
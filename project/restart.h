@@ -0,0 +1,125 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file restart.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the restart policy after fault trips
+ *
+ * Component: FAULT DETECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __RESTART_H
+#define __RESTART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "userparms.h"
+#include "fault.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Restart Rule data type
+
+  Description:
+    Restart rule of a fault class.
+ */
+typedef struct
+{
+    /* Restarts after consecutive faults, 0 latches the fault */
+    uint16_t restarts;
+    /* Delay before the first restart in control cycles */
+    uint32_t delayCount;
+} RESTART_RULE_T;
+
+/* Restart Policy Parameter data type
+
+  Description:
+    This structure will host the counters of the restart policy. The trip,
+    restart and lockout counters are kept from power up and can be read
+    with X2CScope.
+ */
+typedef struct
+{
+    /* Trips of each fault class since power up */
+    uint16_t tripCount[FAULT_CLASS_COUNT];
+    /* Restarts since power up */
+    uint16_t restartTotal;
+    /* Lockouts since power up */
+    uint16_t lockoutTotal;
+    /* Consecutive restarts of each fault class */
+    uint16_t consecutive[FAULT_CLASS_COUNT];
+    /* Nonzero while locked out */
+    uint16_t lockout;
+    /* Control cycles run without faults, up to FAULT_RESTART_CLEAR_SEC */
+    uint32_t runCount;
+    /* Time since power up in seconds */
+    uint32_t seconds;
+    /* Control cycles in the present second */
+    uint16_t secondCount;
+    /* Times of the last FAULT_LOCKOUT_TRIPS trips, a ring buffer */
+    uint32_t tripTime[FAULT_LOCKOUT_TRIPS];
+    /* Position of the oldest trip time */
+    uint16_t tripIndex;
+    /* Trip times stored, up to FAULT_LOCKOUT_TRIPS */
+    uint16_t tripStored;
+} RESTART_PARM_T;
+
+extern RESTART_PARM_T restartParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitRestartParams(void);
+void RestartStepIsr(uint16_t running);
+uint32_t RestartPolicy(uint16_t faultClass);
+void RestartExecuted(void);
+void RestartClear(void);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RESTART_H */
@@ -52,6 +52,7 @@
 
 #include "pwm.h"
 #include "singleshunt.h"
+#include "userparms.h"
 
 // </editor-fold>
 
@@ -64,6 +65,9 @@ SINGLE_SHUNT_PARM_T singleShuntParam;
 // <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
 inline static void SingleShunt_CalculateSwitchingTime(SINGLE_SHUNT_PARM_T *,
                                                                        uint16_t);
+#ifdef SINGLE_SHUNT_PREDICTION
+inline static int16_t SingleShunt_WindowConfidence(int16_t,int16_t);
+#endif
 
 // </editor-fold>
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
@@ -85,6 +89,10 @@ void SingleShunt_InitializeParameters(SINGLE_SHUNT_PARM_T *pSingleShunt)
 	pSingleShunt->tcrit = SSTCRIT;
     /* Set delay due to dead time and slew rate etc.*/
 	pSingleShunt->tDelaySample = SS_SAMPLE_DELAY;
+    /* Set window length giving a settled sample */
+    pSingleShunt->tSettle = SSTSETTLE;
+    pSingleShunt->confidence1 = 0;
+    pSingleShunt->confidence2 = 0;
     /*Trigger  values of Bus Current Samples made equal to zero */
     pSingleShunt->trigger1 = 0;
     pSingleShunt->trigger2 = 0;
@@ -251,6 +259,9 @@ uint16_t SingleShunt_CalculateSpaceVectorPhaseShifted(MC_ABC_T *abc,
 inline static void SingleShunt_CalculateSwitchingTime(SINGLE_SHUNT_PARM_T *pSingleShunt,
         uint16_t iPwmPeriod)
 {
+#ifdef SINGLE_SHUNT_MIN_DISTORTION
+    int16_t deficit1,deficit2,shiftA,shiftB;
+#endif
 	
     // First of all, calculate times corresponding to actual Space Vector
 	// modulation output.
@@ -259,6 +270,47 @@ inline static void SingleShunt_CalculateSwitchingTime(SINGLE_SHUNT_PARM_T *pSing
     pSingleShunt->T2 = (int16_t) (__builtin_mulss(iPwmPeriod,pSingleShunt->T2) >> 15);
     pSingleShunt->T7 = (iPwmPeriod-pSingleShunt->T1-pSingleShunt->T2)>>1;
 
+#ifdef SINGLE_SHUNT_MIN_DISTORTION
+    /* Missing window length of T1 (between the Tc and Tb edges) and of T2 
+    (between the Tb and Ta edges).
+    The windows are opened in the first half of the PWM period and the 
+    edges are moved back by the same amount in the second half, so that the 
+    volt-seconds of every leg are preserved. Instead of moving one edge by 
+    the full deficit, the shift is shared by the three legs: 
+        Ta moves by +(deficit1+deficit2)/2
+        Tb moves by +(deficit1-deficit2)/2
+        Tc moves by -(deficit1+deficit2)/2
+    which opens both windows with the smallest shift of any leg. The 
+    asymmetry of each leg, which causes the current ripple and acoustic 
+    noise at low modulation, is halved. */
+    deficit1 = pSingleShunt->tcrit - pSingleShunt->T1;
+    if (deficit1 < 0)
+    {
+        deficit1 = 0;
+    }
+    deficit2 = pSingleShunt->tcrit - pSingleShunt->T2;
+    if (deficit2 < 0)
+    {
+        deficit2 = 0;
+    }
+    shiftA = (deficit1 + deficit2) >> 1;
+    shiftB = (deficit1 - deficit2) >> 1;
+    
+    pSingleShunt->Tc1 = pSingleShunt->T7 - shiftA;
+    pSingleShunt->Tc2 = pSingleShunt->T7 + shiftA;
+    pSingleShunt->Tb1 = pSingleShunt->T7 + pSingleShunt->T1 + shiftB;
+    pSingleShunt->Tb2 = pSingleShunt->T7 + pSingleShunt->T1 - shiftB;
+    pSingleShunt->Ta1 = pSingleShunt->T7 + pSingleShunt->T1 + 
+                        pSingleShunt->T2 + shiftA;
+    pSingleShunt->Ta2 = pSingleShunt->T7 + pSingleShunt->T1 + 
+                        pSingleShunt->T2 - shiftA;
+    /* Window T1 lost to the rounding of odd deficits */
+    if ((deficit1 + deficit2) & 1)
+    {
+        pSingleShunt->Tc1 = pSingleShunt->Tc1 - 1;
+        pSingleShunt->Tc2 = pSingleShunt->Tc2 + 1;
+    }
+#else
 	/* If PWM counter is already counting down, in which case any modification to 
         duty cycles will take effect until PWM counter starts counting up again. 
         This is why the correction of any modifications done during PWM Timer is
@@ -307,8 +359,47 @@ inline static void SingleShunt_CalculateSwitchingTime(SINGLE_SHUNT_PARM_T *pSing
         pSingleShunt->Ta1 = pSingleShunt->Tb1 + pSingleShunt->tcrit;
         pSingleShunt->Ta2 = pSingleShunt->Tb2 + pSingleShunt->T2 + pSingleShunt->T2 - pSingleShunt->tcrit;
     }
+#endif
+#ifdef SINGLE_SHUNT_PREDICTION
+    /* Validity of the bus current samples from the length of the windows 
+    they are taken in, windows shorter than tSettle give samples that are 
+    not fully settled */
+    pSingleShunt->confidence1 = SingleShunt_WindowConfidence(
+                    pSingleShunt->Tb1 - pSingleShunt->Tc1,pSingleShunt->tSettle);
+    pSingleShunt->confidence2 = SingleShunt_WindowConfidence(
+                    pSingleShunt->Ta1 - pSingleShunt->Tb1,pSingleShunt->tSettle);
+#endif
 
 }
+#ifdef SINGLE_SHUNT_PREDICTION
+/**
+* <B> Function: int16_t SingleShunt_WindowConfidence(int16_t,int16_t) </B>
+*
+* @brief Function to calculate the validity of a bus current sample.
+*
+* @param Length of the window the sample is taken in.
+* @param Window length giving a settled sample.
+* @return Confidence, window/tSettle in Q15 limited to Q15(0.9999).
+* @example
+* <CODE> confidence = SingleShunt_WindowConfidence(window,tSettle); </CODE>
+*
+*/
+inline static int16_t SingleShunt_WindowConfidence(int16_t window,int16_t tSettle)
+{
+    if (window >= tSettle)
+    {
+        return 0x7FFF;
+    }
+    else if (window <= 0)
+    {
+        return 0;
+    }
+    else
+    {
+        return __builtin_divf(window,tSettle);
+    }
+}
+#endif
 /**
 * <B> Function: void SingleShunt_PhaseCurrentReconstruction(SINGLE_SHUNT_PARM_T *)</B>
 *
@@ -378,5 +469,35 @@ void ResetSingleShuntSamplePoint(SINGLE_SHUNT_PARM_T *pSingleShunt)
         pSingleShunt->adcSamplePoint = 0;
     }  
 }
+/**
+* <B> Function: void SingleShunt_ShiftPattern(SINGLE_SHUNT_PARM_T *,int16_t)</B>
+*
+* @brief Function to shift the PWM pattern and the ADC triggers in time.
+*
+* Adding the same offset to all duty cycles changes only the zero sequence
+* voltage. The measurement windows keep their length and the triggers are
+* moved with the pattern, so the bus current samples remain valid.
+*
+* @param Pointer to the data structure containing Single Shunt parameters.
+* @param Offset added to the duty cycles of both halves of the PWM period.
+* @return none.
+* @example
+* <CODE> SingleShunt_ShiftPattern(&singleShuntParam,offset); </CODE>
+*
+*/
+void SingleShunt_ShiftPattern(SINGLE_SHUNT_PARM_T *pSingleShunt,int16_t offset)
+{
+    pSingleShunt->pwmDutycycle1.dutycycle1 += offset;
+    pSingleShunt->pwmDutycycle1.dutycycle2 += offset;
+    pSingleShunt->pwmDutycycle1.dutycycle3 += offset;
+    pSingleShunt->pwmDutycycle2.dutycycle1 += offset;
+    pSingleShunt->pwmDutycycle2.dutycycle2 += offset;
+    pSingleShunt->pwmDutycycle2.dutycycle3 += offset;
+    
+    pSingleShunt->trigger1 = pSingleShunt->trigger1 - offset;
+    pSingleShunt->trigger2 = pSingleShunt->trigger2 - offset;
+    PWM_TRIGB = pSingleShunt->trigger1;
+    PWM_TRIGC = pSingleShunt->trigger2;
+}
 
 // </editor-fold>
\ No newline at end of file
@@ -68,6 +68,10 @@ extern "C" {
 #define SSTCRIT         (uint16_t)(SSTCRITINSEC*FCY*2)
 /* Single shunt algorithm defines *2 because is same resolution as PDCx registers */
 #define SS_SAMPLE_DELAY  150
+/*  Window in seconds giving a fully settled bus current sample */
+#define SSTSETTLEINSEC	3.0E-6
+/* Single shunt algorithm defines *2 because is same resolution as PDCx registers */
+#define SSTSETTLE       (uint16_t)(SSTSETTLEINSEC*FCY*2)
 
 // </editor-fold>
 
@@ -111,6 +115,9 @@ typedef struct
                                be stored in TRIG1 register to trigger
                                A/D conversion */
     int16_t adcSamplePoint;
+    int16_t tSettle;            /* Window length for a settled sample */
+    int16_t confidence1;        /* Validity of Ibus1, 0 to Q15(0.9999) */
+    int16_t confidence2;        /* Validity of Ibus2, 0 to Q15(0.9999) */
     MC_DUTYCYCLEOUT_T pwmDutycycle1;
     MC_DUTYCYCLEOUT_T pwmDutycycle2;
     
@@ -135,6 +142,7 @@ uint16_t SingleShunt_CalculateSpaceVectorPhaseShifted(MC_ABC_T *abc,
                                     SINGLE_SHUNT_PARM_T *pSingleShunt);
 void SingleShunt_PhaseCurrentReconstruction(SINGLE_SHUNT_PARM_T *pSingleShunt);
 void ResetSingleShuntSamplePoint(SINGLE_SHUNT_PARM_T *pSingleShunt);
+void SingleShunt_ShiftPattern(SINGLE_SHUNT_PARM_T *pSingleShunt,int16_t offset);
     
 // </editor-fold>
     
@@ -0,0 +1,433 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file speedctrl.c
+ *
+ * @brief This module schedules the speed controller gains with the speed,
+ * adapts them to the estimated load inertia and feeds the acceleration of
+ * the speed reference ramp forward to the Iq reference.
+ *
+ * Component: SPEED CONTROL
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "speedctrl.h"
+#include "general.h"
+#include "userparms.h"
+#ifdef SPEED_REF_SCURVE
+#include "speedramp.h"
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Binary point of the inertia and of the table position */
+#define SPEEDCTRL_Q             12
+/* Tuned inertia in SPEEDCTRL_Q */
+#define SPEEDCTRL_ONE           4096
+/* Limits of the inertia */
+#define SPEEDCTRL_INERTIA_MIN   (int16_t)(SPEEDCTRL_ONE*SPEED_INERTIA_MIN)
+#define SPEEDCTRL_INERTIA_MAX   (int16_t)(SPEEDCTRL_ONE*SPEED_INERTIA_MAX)
+/* Gain converting the speed into the table position in SPEEDCTRL_Q */
+#define SPEEDCTRL_INDEX_GAIN    (int16_t)((SPEED_GAIN_TABLE_SIZE - 1)* \
+                                    SPEEDCTRL_ONE*32768.0/MAXIMUMSPEED_ELECTR)
+/* Shift of the acceleration current to inertia conversion */
+#define SPEEDCTRL_INERTIA_SHIFT 11
+/* Gain converting the acceleration current into the inertia */
+#define SPEEDCTRL_INERTIA_GAIN  (int16_t)(SPEEDCTRL_ONE* \
+                    (float)(1 << SPEEDCTRL_INERTIA_SHIFT)/SPEED_ACCEL_CURRENT)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+SPEEDCTRL_PARM_T speedCtrlParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static int16_t SpeedCtrlInterpolate(const int16_t *pCurve, uint16_t index,
+                                    int16_t qFraction);
+static int16_t SpeedCtrlScale(int16_t qGain);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitSpeedCtrlParams()
+
+  Summary:
+    Initializes speed control parameters
+
+  Description:
+    This routine initializes the gain table and the constants of the speed
+    control structure, sets the inertia to SPEED_INERTIA_INIT and resets the
+    estimation.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the estimated inertia is kept when the motor is
+    stopped and restarted.
+ */
+void InitSpeedCtrlParams(void)
+{
+    speedCtrlParm.qKpCurve[0] = SPEED_GAIN_KP0;
+    speedCtrlParm.qKpCurve[1] = SPEED_GAIN_KP1;
+    speedCtrlParm.qKpCurve[2] = SPEED_GAIN_KP2;
+    speedCtrlParm.qKpCurve[3] = SPEED_GAIN_KP3;
+    speedCtrlParm.qKpCurve[4] = SPEED_GAIN_KP4;
+
+    speedCtrlParm.qKiCurve[0] = SPEED_GAIN_KI0;
+    speedCtrlParm.qKiCurve[1] = SPEED_GAIN_KI1;
+    speedCtrlParm.qKiCurve[2] = SPEED_GAIN_KI2;
+    speedCtrlParm.qKiCurve[3] = SPEED_GAIN_KI3;
+    speedCtrlParm.qKiCurve[4] = SPEED_GAIN_KI4;
+
+    speedCtrlParm.qIndexGain = SPEEDCTRL_INDEX_GAIN;
+    speedCtrlParm.qIqAccel = SPEED_ACCEL_CURRENT;
+    speedCtrlParm.qInertiaGain = SPEEDCTRL_INERTIA_GAIN;
+    speedCtrlParm.qKInertia = SPEED_INERTIA_FILTER;
+    speedCtrlParm.qKLoad = SPEED_LOAD_FILTER;
+    speedCtrlParm.qInertia = (int16_t)(SPEEDCTRL_ONE*SPEED_INERTIA_INIT);
+    speedCtrlParm.qInertiaStateVar = (int32_t)speedCtrlParm.qInertia << 15;
+
+    SpeedCtrlReset(0);
+}
+// *****************************************************************************
+
+/* Function:
+    SpeedCtrlReset()
+
+  Summary:
+    Resets the load current and the acceleration feed forward
+
+  Description:
+    The load current, the ramp direction and the feed forward are set to
+    zero, the estimated inertia is not changed.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qVelRef - present speed reference
+
+  Returns:
+    None.
+
+  Remarks:
+    Called when the motor is stopped and when the speed controller is
+    started from the open loop.
+ */
+void SpeedCtrlReset(int16_t qVelRef)
+{
+    speedCtrlParm.qIqLoad = 0;
+    speedCtrlParm.qIqLoadStateVar = 0;
+    speedCtrlParm.qIqFF = 0;
+    speedCtrlParm.qLastVelRef = qVelRef;
+    speedCtrlParm.qAccel = 0;
+    speedCtrlParm.accelHold = 0;
+}
+// *****************************************************************************
+
+/* Function:
+    SpeedCtrlSchedule()
+
+  Summary:
+    Sets the speed controller gains for the present speed and inertia
+
+  Description:
+    The gains are interpolated linearly in the tables of
+    SPEED_GAIN_TABLE_SIZE points equally spaced from zero to
+    MAXIMUM_SPEED_RPM, and multiplied by the estimated inertia so that the
+    bandwidth of the speed loop does not depend on the load inertia.
+    The acceleration of the speed reference is taken from the S-curve
+    generator, or with the linear ramp detected from the change of the
+    reference and held over the SPEEDREFRAMP_COUNT cycles between the ramp
+    steps. Reference steps larger than SPEEDREFRAMP, like the change from
+    open loop, are not taken as a ramp.
+
+  Precondition:
+    Called once every control cycle before the speed controller.
+
+  Parameters:
+    qVelRef - speed reference
+    qVel - estimated speed
+    pPiState - pointer to the speed controller state
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void SpeedCtrlSchedule(int16_t qVelRef, int16_t qVel, MC_PISTATE_T *pPiState)
+{
+    int16_t qFraction;
+    int32_t position;
+    uint16_t index;
+
+#ifdef SPEED_REF_SCURVE
+    speedCtrlParm.qLastVelRef = qVelRef;
+    speedCtrlParm.qAccel = speedRampParm.qAccel;
+#else
+    int16_t qDelta;
+
+    qDelta = qVelRef - speedCtrlParm.qLastVelRef;
+    speedCtrlParm.qLastVelRef = qVelRef;
+    if ((qDelta != 0) && (_Q15abs(qDelta) <= SPEEDREFRAMP))
+    {
+        speedCtrlParm.qAccel = (qDelta > 0) ? SPEEDCTRL_ONE : -SPEEDCTRL_ONE;
+        speedCtrlParm.accelHold = SPEEDREFRAMP_COUNT;
+    }
+    else if (speedCtrlParm.accelHold > 0)
+    {
+        speedCtrlParm.accelHold--;
+    }
+    else
+    {
+        speedCtrlParm.qAccel = 0;
+    }
+#endif
+
+    position = __builtin_mulss(_Q15abs(qVel), speedCtrlParm.qIndexGain) >> 15;
+    index = (uint16_t)(position >> SPEEDCTRL_Q);
+    if (index >= (SPEED_GAIN_TABLE_SIZE - 1))
+    {
+        index = SPEED_GAIN_TABLE_SIZE - 2;
+        qFraction = SPEEDCTRL_ONE;
+    }
+    else
+    {
+        qFraction = (int16_t)(position & (SPEEDCTRL_ONE - 1));
+    }
+
+    pPiState->kp = SpeedCtrlScale(SpeedCtrlInterpolate(speedCtrlParm.qKpCurve,
+                                                       index, qFraction));
+    pPiState->ki = SpeedCtrlScale(SpeedCtrlInterpolate(speedCtrlParm.qKiCurve,
+                                                       index, qFraction));
+}
+// *****************************************************************************
+
+/* Function:
+    SpeedCtrlFeedForward()
+
+  Summary:
+    Adds the acceleration feed forward and estimates the inertia
+
+  Description:
+    The current accelerating the estimated inertia, SPEED_ACCEL_CURRENT
+    times the inertia and the acceleration, is added to the speed controller
+    output. At constant speed reference the Iq reference is filtered as the
+    load current. While the speed reference accelerates by at least half the
+    ramp rate, the Iq reference minus the load current and the feed forward
+    is the acceleration current not covered by the estimated inertia. Its
+    ratio to SPEED_ACCEL_CURRENT, in the direction of the acceleration,
+    corrects the inertia through the filter SPEED_INERTIA_FILTER. The
+    correction is zero when the feed forward matches the acceleration
+    current, with a wrong inertia the speed controller supplies the
+    remaining current.
+
+  Precondition:
+    SpeedCtrlSchedule() must be called in the same control cycle.
+
+  Parameters:
+    qIqRef - speed controller output
+
+  Returns:
+    Iq reference limited to SPEEDCNTR_OUTMAX.
+
+  Remarks:
+    The inertia is not updated while the Iq reference is limited.
+ */
+int16_t SpeedCtrlFeedForward(int16_t qIqRef)
+{
+    int32_t iq, correction;
+    int16_t tempint;
+
+    tempint = (int16_t)(__builtin_mulss(speedCtrlParm.qIqAccel,
+                                speedCtrlParm.qInertia) >> SPEEDCTRL_Q);
+    iq = __builtin_mulss(tempint, speedCtrlParm.qAccel) >> SPEEDCTRL_Q;
+    if (iq > SPEEDCNTR_OUTMAX)
+    {
+        iq = SPEEDCNTR_OUTMAX;
+    }
+    else if (iq < -SPEEDCNTR_OUTMAX)
+    {
+        iq = -SPEEDCNTR_OUTMAX;
+    }
+    speedCtrlParm.qIqFF = (int16_t)iq;
+
+    iq = (int32_t)qIqRef + speedCtrlParm.qIqFF;
+    if (iq >= SPEEDCNTR_OUTMAX)
+    {
+        iq = SPEEDCNTR_OUTMAX;
+    }
+    else if (iq <= -SPEEDCNTR_OUTMAX)
+    {
+        iq = -SPEEDCNTR_OUTMAX;
+    }
+    else if (speedCtrlParm.qAccel == 0)
+    {
+        tempint = (int16_t)iq - speedCtrlParm.qIqLoad;
+        speedCtrlParm.qIqLoadStateVar += __builtin_mulss(tempint,
+                                                    speedCtrlParm.qKLoad);
+        speedCtrlParm.qIqLoad =
+                            (int16_t)(speedCtrlParm.qIqLoadStateVar >> 15);
+    }
+    else if (_Q15abs(speedCtrlParm.qAccel) >= (SPEEDCTRL_ONE >> 1))
+    {
+        tempint = (int16_t)iq - speedCtrlParm.qIqLoad - speedCtrlParm.qIqFF;
+        if (speedCtrlParm.qAccel < 0)
+        {
+            tempint = -tempint;
+        }
+        correction = __builtin_mulss(tempint, speedCtrlParm.qInertiaGain) >>
+                                                    SPEEDCTRL_INERTIA_SHIFT;
+        if (correction > SPEEDCTRL_INERTIA_MAX)
+        {
+            correction = SPEEDCTRL_INERTIA_MAX;
+        }
+        else if (correction < -SPEEDCTRL_INERTIA_MAX)
+        {
+            correction = -SPEEDCTRL_INERTIA_MAX;
+        }
+        speedCtrlParm.qInertiaStateVar += __builtin_mulss((int16_t)correction,
+                                                    speedCtrlParm.qKInertia);
+        if (speedCtrlParm.qInertiaStateVar <
+                                    ((int32_t)SPEEDCTRL_INERTIA_MIN << 15))
+        {
+            speedCtrlParm.qInertiaStateVar =
+                                    (int32_t)SPEEDCTRL_INERTIA_MIN << 15;
+        }
+        else if (speedCtrlParm.qInertiaStateVar >
+                                    ((int32_t)SPEEDCTRL_INERTIA_MAX << 15))
+        {
+            speedCtrlParm.qInertiaStateVar =
+                                    (int32_t)SPEEDCTRL_INERTIA_MAX << 15;
+        }
+        speedCtrlParm.qInertia =
+                            (int16_t)(speedCtrlParm.qInertiaStateVar >> 15);
+    }
+    return (int16_t)iq;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    SpeedCtrlInterpolate()
+
+  Summary:
+    Linear interpolation in a gain table
+
+  Description:
+    Returns pCurve[index] + qFraction * (pCurve[index + 1] - pCurve[index]).
+
+  Precondition:
+    None.
+
+  Parameters:
+    pCurve - pointer to the gain table
+    index - table point below the speed
+    qFraction - position between the table points in SPEEDCTRL_Q
+
+  Returns:
+    Interpolated gain.
+
+  Remarks:
+    None.
+ */
+static int16_t SpeedCtrlInterpolate(const int16_t *pCurve, uint16_t index,
+                                    int16_t qFraction)
+{
+    int16_t qDiff = pCurve[index + 1] - pCurve[index];
+
+    return pCurve[index] +
+            (int16_t)(__builtin_mulss(qDiff, qFraction) >> SPEEDCTRL_Q);
+}
+// *****************************************************************************
+
+/* Function:
+    SpeedCtrlScale()
+
+  Summary:
+    Multiplies a gain with the estimated inertia
+
+  Description:
+    Returns qGain * speedCtrlParm.qInertia limited to the Q15 range.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qGain - gain for the tuned inertia
+
+  Returns:
+    Gain for the estimated inertia.
+
+  Remarks:
+    None.
+ */
+static int16_t SpeedCtrlScale(int16_t qGain)
+{
+    int32_t gain = __builtin_mulss(qGain, speedCtrlParm.qInertia) >>
+                                                            SPEEDCTRL_Q;
+
+    if (gain > Q15(0.9999))
+    {
+        gain = Q15(0.9999);
+    }
+    return (int16_t)gain;
+}
+
+// </editor-fold>
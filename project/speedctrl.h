@@ -0,0 +1,121 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file speedctrl.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the speed controller gain scheduling and inertia adaptation
+ *
+ * Component: SPEED CONTROL
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __SPEEDCTRL_H
+#define __SPEEDCTRL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+#include "userparms.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Speed Control Parameter data type
+
+  Description:
+    This structure will host parameters related to the scheduling of the
+    speed controller gains with the speed, the estimation of the load inertia
+    and the acceleration feed forward. The inertia is in Q12, 4096 is the
+    inertia for which the gain table is tuned.
+ */
+typedef struct
+{
+    /* Proportional gains at the table speeds */
+    int16_t qKpCurve[SPEED_GAIN_TABLE_SIZE];
+    /* Integral gains at the table speeds */
+    int16_t qKiCurve[SPEED_GAIN_TABLE_SIZE];
+    /* Gain converting the speed into the table position */
+    int16_t qIndexGain;
+    /* Inertia relative to the tuned inertia */
+    int16_t qInertia;
+    /* State variable for the inertia */
+    int32_t qInertiaStateVar;
+    /* Filter constant of the inertia */
+    int16_t qKInertia;
+    /* Gain converting the acceleration current into the inertia */
+    int16_t qInertiaGain;
+    /* Current accelerating the tuned inertia at the reference ramp */
+    int16_t qIqAccel;
+    /* Load current, Iq reference at constant speed */
+    int16_t qIqLoad;
+    /* State variable for the load current */
+    int32_t qIqLoadStateVar;
+    /* Filter constant of the load current */
+    int16_t qKLoad;
+    /* Acceleration feed forward current */
+    int16_t qIqFF;
+    /* Speed reference of the previous control cycle */
+    int16_t qLastVelRef;
+    /* Acceleration of the speed reference relative to the ramp rate
+       SPEEDREFRAMP per SPEEDREFRAMP_COUNT + 1 control cycles */
+    int16_t qAccel;
+    /* Control cycles between the ramp steps */
+    uint16_t accelHold;
+} SPEEDCTRL_PARM_T;
+
+extern SPEEDCTRL_PARM_T speedCtrlParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitSpeedCtrlParams(void);
+void SpeedCtrlReset(int16_t qVelRef);
+void SpeedCtrlSchedule(int16_t qVelRef, int16_t qVel, MC_PISTATE_T *pPiState);
+int16_t SpeedCtrlFeedForward(int16_t qIqRef);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPEEDCTRL_H */
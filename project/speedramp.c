@@ -0,0 +1,300 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file speedramp.c
+ *
+ * @brief This module generates the speed reference with limited acceleration
+ * and jerk, an S-curve trajectory from the present to the target speed.
+ *
+ * Component: SPEED REFERENCE RAMP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "speedramp.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Binary point of the accelerations */
+#define SPEEDRAMP_Q             12
+/* Acceleration of the linear ramp in SPEEDRAMP_Q */
+#define SPEEDRAMP_ONE           4096
+/* Control cycles from zero to the linear ramp acceleration */
+#define SPEEDRAMP_JERK_CYCLES   (SPEED_RAMP_JERK_TIME_MSEC*0.001/LOOPTIME_SEC)
+/* Acceleration change per control cycle, 15 more fractional bits */
+#define SPEEDRAMP_JERK          (int32_t)(SPEEDRAMP_ONE*32768.0/ \
+                                    SPEEDRAMP_JERK_CYCLES)
+/* Speed change per control cycle at the linear ramp acceleration, 16 
+   fractional bits, in SPEEDRAMP_Q */
+#define SPEEDRAMP_VEL_GAIN      (int16_t)(SPEEDREFRAMP*65536.0/ \
+                                    (SPEEDREFRAMP_COUNT + 1))
+/* Half the control cycles to bring the acceleration to zero per 
+   acceleration unit, in Q15, below 32768 for SPEED_RAMP_JERK_TIME_MSEC up 
+   to 409 */
+#define SPEEDRAMP_STOP_GAIN     (int16_t)(SPEEDRAMP_JERK_CYCLES*32768.0/ \
+                                    (2*SPEEDRAMP_ONE))
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+SPEEDRAMP_PARM_T speedRampParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitSpeedRampParams()
+
+  Summary:
+    Initializes speed reference generator parameters
+
+  Description:
+    This routine initializes the speed reference generator structure
+    variables at zero speed and acceleration
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void InitSpeedRampParams(void)
+{
+    speedRampParm.qVelStateVar = 0;
+    speedRampParm.qLastVelRef = 0;
+    speedRampParm.qAccel = 0;
+    speedRampParm.qAccelStateVar = 0;
+    speedRampParm.jerk = SPEEDRAMP_JERK;
+    speedRampParm.qAccelMax = (int16_t)(SPEEDRAMP_ONE*SPEED_RAMP_ACCEL);
+    speedRampParm.qDecelMax = (int16_t)(SPEEDRAMP_ONE*SPEED_RAMP_DECEL);
+    speedRampParm.qVelGain = SPEEDRAMP_VEL_GAIN;
+    speedRampParm.qStopGain = SPEEDRAMP_STOP_GAIN;
+    speedRampParm.qAccelScale = Q15(0.9999);
+}
+// *****************************************************************************
+
+/* Function:
+    SpeedRampUpdate()
+
+  Summary:
+    Moves the speed reference one control cycle towards the target speed
+
+  Description:
+    The acceleration changes by at most the jerk limit per control cycle and
+    is limited to SPEED_RAMP_ACCEL while the speed magnitude increases and
+    to SPEED_RAMP_DECEL while it decreases. The acceleration is reduced
+    towards zero as soon as the remaining speed error is within the speed
+    change a*a/(2*jerk) needed to bring it to zero, so that the speed
+    reference reaches the target with zero acceleration. When the speed
+    reference crosses the target it is set to the target and the
+    acceleration to zero.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    qVelRef - present speed reference
+    qTargetSpeed - target speed
+
+  Returns:
+    New speed reference.
+
+  Remarks:
+    If the speed reference was changed outside of the generator, at the
+    change to closed loop or by the flying start, the generator continues
+    from it with zero acceleration. The speed error is calculated in 32
+    bits, the targets of opposite sign do not wrap around.
+ */
+int16_t SpeedRampUpdate(int16_t qVelRef, int16_t qTargetSpeed)
+{
+    int32_t error, accelTarget, accel, stopping;
+    int16_t qLimit, qAbsAccel, qCycles;
+
+    if (qVelRef != speedRampParm.qLastVelRef)
+    {
+        speedRampParm.qVelStateVar = (int32_t)qVelRef << 16;
+        speedRampParm.qAccelStateVar = 0;
+        speedRampParm.qAccel = 0;
+    }
+
+    error = ((int32_t)qTargetSpeed << 16) - speedRampParm.qVelStateVar;
+
+    /* Limit for increasing or decreasing speed magnitude */
+    if (((error > 0) && (speedRampParm.qVelStateVar >= 0)) ||
+        ((error < 0) && (speedRampParm.qVelStateVar <= 0)))
+    {
+        qLimit = speedRampParm.qAccelMax;
+    }
+    else
+    {
+        qLimit = speedRampParm.qDecelMax;
+    }
+    qLimit = (int16_t)(__builtin_mulss(qLimit,
+                                speedRampParm.qAccelScale) >> 15);
+
+    /* Speed change until the acceleration is brought to zero, the product 
+       of the speed change per cycle and half the cycles, 8 fractional bits,
+       both rounded up so that the acceleration is reduced in time */
+    qAbsAccel = _Q15abs(speedRampParm.qAccel);
+    qCycles = (int16_t)(__builtin_mulss(qAbsAccel,
+                                speedRampParm.qStopGain) >> 15) + 1;
+    stopping = __builtin_mulss((int16_t)(__builtin_mulss(qAbsAccel,
+                speedRampParm.qVelGain) >> (SPEEDRAMP_Q + 8)) + 1, qCycles);
+
+    if (error > 0)
+    {
+        if ((speedRampParm.qAccel > 0) && ((error >> 8) <= stopping))
+        {
+            accelTarget = 0;
+        }
+        else
+        {
+            accelTarget = qLimit;
+        }
+    }
+    else if (error < 0)
+    {
+        if ((speedRampParm.qAccel < 0) && ((-error >> 8) <= stopping))
+        {
+            accelTarget = 0;
+        }
+        else
+        {
+            accelTarget = -qLimit;
+        }
+    }
+    else
+    {
+        accelTarget = 0;
+    }
+
+    /* Jerk limitation */
+    accel = (accelTarget << 15) - speedRampParm.qAccelStateVar;
+    if (accel > speedRampParm.jerk)
+    {
+        accel = speedRampParm.jerk;
+    }
+    else if (accel < -speedRampParm.jerk)
+    {
+        accel = -speedRampParm.jerk;
+    }
+    speedRampParm.qAccelStateVar += accel;
+    speedRampParm.qAccel = (int16_t)(speedRampParm.qAccelStateVar >> 15);
+
+    speedRampParm.qVelStateVar += __builtin_mulss(speedRampParm.qAccel,
+                                    speedRampParm.qVelGain) >> SPEEDRAMP_Q;
+
+    /* Target reached or crossed */
+    accel = ((int32_t)qTargetSpeed << 16) - speedRampParm.qVelStateVar;
+    if ((error == 0) || ((error > 0) && (accel <= 0)) ||
+        ((error < 0) && (accel >= 0)))
+    {
+        speedRampParm.qVelStateVar = (int32_t)qTargetSpeed << 16;
+        speedRampParm.qAccelStateVar = 0;
+        speedRampParm.qAccel = 0;
+    }
+
+    speedRampParm.qLastVelRef = (int16_t)(speedRampParm.qVelStateVar >> 16);
+    return speedRampParm.qLastVelRef;
+}
+// *****************************************************************************
+
+/* Function:
+    SpeedRampAdapt()
+
+  Summary:
+    Scales the acceleration limits with the current headroom
+
+  Description:
+    In the time optimal mode SPEED_RAMP_ACCEL and SPEED_RAMP_DECEL are the
+    largest accelerations allowed. While the Iq reference exceeds
+    SPEED_RAMP_CURRENT_LIMIT the limits are reduced quickly, otherwise they
+    are increased slowly back, so that the speed changes as fast as the
+    current limit allows while the speed controller keeps a margin.
+
+  Precondition:
+    Called once every control cycle after the speed controller.
+
+  Parameters:
+    qIqRef - Iq reference
+
+  Returns:
+    None.
+
+  Remarks:
+    Without SPEED_RAMP_TIME_OPTIMAL the limits are not scaled.
+ */
+void SpeedRampAdapt(int16_t qIqRef)
+{
+    int16_t qScale = speedRampParm.qAccelScale;
+
+    if (_Q15abs(qIqRef) > SPEED_RAMP_CURRENT_LIMIT)
+    {
+        qScale -= SPEED_RAMP_SCALE_DOWN;
+        if (qScale < SPEED_RAMP_SCALE_MIN)
+        {
+            qScale = SPEED_RAMP_SCALE_MIN;
+        }
+    }
+    else if (qScale < (Q15(0.9999) - SPEED_RAMP_SCALE_UP))
+    {
+        qScale += SPEED_RAMP_SCALE_UP;
+    }
+    else
+    {
+        qScale = Q15(0.9999);
+    }
+    speedRampParm.qAccelScale = qScale;
+}
+
+// </editor-fold>
@@ -0,0 +1,106 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file speedramp.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the jerk limited speed reference generator
+ *
+ * Component: SPEED REFERENCE RAMP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __SPEEDRAMP_H
+#define __SPEEDRAMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Speed Reference Ramp Parameter data type
+
+  Description:
+    This structure will host parameters related to the jerk limited speed
+    reference generator. Accelerations are in Q12 relative to the linear
+    ramp rate SPEEDREFRAMP per SPEEDREFRAMP_COUNT + 1 control cycles.
+ */
+typedef struct
+{
+    /* Speed reference, 16 fractional bits */
+    int32_t qVelStateVar;
+    /* Speed reference of the previous control cycle */
+    int16_t qLastVelRef;
+    /* Acceleration */
+    int16_t qAccel;
+    /* State variable for the acceleration, 15 more fractional bits */
+    int32_t qAccelStateVar;
+    /* Acceleration change per control cycle in the state variable format */
+    int32_t jerk;
+    /* Acceleration limit while the speed magnitude increases */
+    int16_t qAccelMax;
+    /* Acceleration limit while the speed magnitude decreases */
+    int16_t qDecelMax;
+    /* Gain converting the acceleration into the speed change per cycle */
+    int16_t qVelGain;
+    /* Gain converting the acceleration into half the control cycles 
+       needed to bring it to zero */
+    int16_t qStopGain;
+    /* Scaling of the acceleration limits by the current headroom */
+    int16_t qAccelScale;
+} SPEEDRAMP_PARM_T;
+
+extern SPEEDRAMP_PARM_T speedRampParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitSpeedRampParams(void);
+int16_t SpeedRampUpdate(int16_t qVelRef, int16_t qTargetSpeed);
+void SpeedRampAdapt(int16_t qIqRef);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPEEDRAMP_H */
@@ -0,0 +1,88 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file xc.h
+ *
+ * @brief Host stand-in for the device header, used by the unit tests only.
+ * The compiler built-in functions of the dsPIC are emulated with their
+ * integer results, the peripheral registers are not declared.
+ *
+ * Component: UNIT TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __HOST_XC_H
+#define __HOST_XC_H
+
+#include <stdint.h>
+
+static inline int32_t __builtin_mulss(int16_t a, int16_t b)
+{
+    return (int32_t)a * b;
+}
+
+static inline int32_t __builtin_mulsu(int16_t a, uint16_t b)
+{
+    return (int32_t)a * b;
+}
+
+static inline uint32_t __builtin_muluu(uint16_t a, uint16_t b)
+{
+    return (uint32_t)a * b;
+}
+
+/* The quotient of the device division is 16 bits wide */
+static inline int16_t __builtin_divsd(int32_t num, int16_t den)
+{
+    return (int16_t)(num / den);
+}
+
+static inline uint16_t __builtin_divud(uint32_t num, uint16_t den)
+{
+    return (uint16_t)(num / den);
+}
+
+static inline int16_t __builtin_divf(int16_t num, int16_t den)
+{
+    return (int16_t)(((int32_t)num << 15) / den);
+}
+
+#define __builtin_disi(x)   ((void)0)
+#define __builtin_nop()     ((void)0)
+
+#endif /* end of __HOST_XC_H */
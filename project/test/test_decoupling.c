@@ -0,0 +1,136 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file test_decoupling.c
+ *
+ * @brief Host unit test of the decoupling feed forward voltages, compares
+ * the fixed point results with omega*Ls*I and omega*Psi calculated in
+ * floating point from the estimator constants of userparms.h.
+ *
+ * Component: UNIT TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+
+#include "unittest.h"
+#include "decoupling.h"
+#include "estim.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Voltage base, phase voltage amplitude at the nominal bus voltage */
+#define TEST_VOLTAGE_BASE   (DC_BUS_VOLTAGE_NOMINAL/1.7320508)
+/* Ls calculated back from NORM_LSDTBASE, in henry */
+#define TEST_LS             (NORM_LSDTBASE/1024.0*LOOPTIME_SEC* \
+                             TEST_VOLTAGE_BASE/(32768.0*NORM_CURRENT_CONST))
+/* Allowed deviation from the floating point value, in Q15 counts */
+#define TEST_TOLERANCE(x)   (0.01*(x) + 4.0)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+MOTOR_ESTIM_PARM_T motorParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="STATIC FUNCTIONS ">
+
+static double ExpectedVoltage(double volts)
+{
+    return volts/TEST_VOLTAGE_BASE*32768.0;
+}
+
+static void TestSpeed(int16_t qVel, double idAmps, double iqAmps)
+{
+    MC_DQ_T idq;
+    double omega = qVel*6.2831853/60.0;
+    double vd, vq;
+
+    idq.d = (int16_t)(idAmps/NORM_CURRENT_CONST);
+    idq.q = (int16_t)(iqAmps/NORM_CURRENT_CONST);
+    DecouplingCalculate(qVel, &idq);
+
+    vd = ExpectedVoltage(-omega*TEST_LS*idq.q*NORM_CURRENT_CONST);
+    vq = ExpectedVoltage(omega*TEST_LS*idq.d*NORM_CURRENT_CONST +
+                         omega*NORM_FLUX_LINKAGE);
+    CHECK_NEAR(decouplingParm.qVdFF, vd, TEST_TOLERANCE(vd < 0 ? -vd : vd));
+    CHECK_NEAR(decouplingParm.qVqFF, vq, TEST_TOLERANCE(vq < 0 ? -vq : vq));
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+int main(void)
+{
+    MC_DQ_T idq;
+
+    motorParm.qLsDt = NORM_VOLTAGE_SCALE(NORM_LSDTBASE);
+    motorParm.qInvKFi = NORM_VOLTAGE_INV_SCALE(NORM_INVKFIBASE);
+    InitDecouplingParams();
+
+    /* Electrical speeds in RPM, at standstill there is no feed forward */
+    TestSpeed(0, 0.0, 1.0);
+    CHECK(decouplingParm.qVdFF == 0);
+    CHECK(decouplingParm.qVqFF == 0);
+    TestSpeed(ENDSPEED_ELECTR, 0.0, 0.5);
+    TestSpeed(NOMINALSPEED_ELECTR, 0.0, 1.0);
+    TestSpeed(NOMINALSPEED_ELECTR, -1.0, 2.0);
+    TestSpeed(-NOMINALSPEED_ELECTR, 0.0, -1.0);
+    TestSpeed(MAXIMUMSPEED_ELECTR, -2.0, 1.0);
+
+    /* The feed forward is limited to DECOUPLING_VOLTAGE_MAX */
+    motorParm.qInvKFi = NORM_INVKFIBASE/2;
+    idq.d = 0;
+    idq.q = 0;
+    DecouplingCalculate(MAXIMUMSPEED_ELECTR, &idq);
+    CHECK(decouplingParm.qVqFF == DECOUPLING_VOLTAGE_MAX);
+    DecouplingCalculate(-MAXIMUMSPEED_ELECTR, &idq);
+    CHECK(decouplingParm.qVqFF == -DECOUPLING_VOLTAGE_MAX);
+
+    return UNIT_TEST_RESULT("test_decoupling");
+}
+
+// </editor-fold>
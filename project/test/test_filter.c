@@ -0,0 +1,195 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file test_filter.c
+ *
+ * @brief Host unit test of the filter library, checks the step responses of
+ * the moving average and the low pass filters, the saturation of the first
+ * order low pass filter and the spike rejection of the median filter.
+ *
+ * Component: UNIT TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <math.h>
+
+#include "unittest.h"
+#include "filter.h"
+#include "general.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Step applied to the filters */
+#define TEST_STEP           10000
+/* First order filter constant, time constant of 1/TEST_LPF_K samples */
+#define TEST_LPF_K          0.01
+/* Second order filter constant and Butterworth damping */
+#define TEST_LPF2_K         0.01
+#define TEST_LPF2_DAMPING   (int16_t)23170
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="VARIABLES ">
+
+static int16_t avgBuffer[1 << 4];
+static int16_t avgBufferLong[1 << MCAPP_FILTER_AVG_SHIFT_MAX];
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="STATIC FUNCTIONS ">
+
+/* Moving average of 16 samples reaches the step after 16 samples, and the
+   longest window neither overflows the sum nor the initialization loop */
+static void TestAvg(void)
+{
+    MCAPP_FILTER_AVG_T filter;
+    int16_t output = 0;
+    long i;
+
+    MCAPP_FilterAvgInit(&filter, avgBuffer, 4, 0);
+    for (i = 1; i <= 16; i++)
+    {
+        output = MCAPP_FilterAvg(&filter, TEST_STEP);
+        CHECK_NEAR(output, TEST_STEP*i/16, 1);
+    }
+    CHECK(output == TEST_STEP);
+    output = MCAPP_FilterAvg(&filter, TEST_STEP);
+    CHECK(output == TEST_STEP);
+
+    MCAPP_FilterAvgInit(&filter, avgBufferLong,
+                        MCAPP_FILTER_AVG_SHIFT_MAX + 1, -INT16_MAX);
+    CHECK(filter.shift == MCAPP_FILTER_AVG_SHIFT_MAX);
+    CHECK(filter.mask == (1U << MCAPP_FILTER_AVG_SHIFT_MAX) - 1);
+    for (i = 0; i < (1L << MCAPP_FILTER_AVG_SHIFT_MAX); i++)
+    {
+        output = MCAPP_FilterAvg(&filter, INT16_MAX);
+    }
+    CHECK(output == INT16_MAX);
+}
+
+/* First order low pass filter reaches 1 - 1/e of the step after one time
+   constant, and the full scale step rises without wrap around */
+static void TestLPF(void)
+{
+    MCAPP_FILTER_LPF_T filter;
+    int16_t output = 0;
+    int16_t previous;
+    int i;
+
+    MCAPP_FilterLPFInit(&filter, Q15(TEST_LPF_K), 0);
+    for (i = 0; i < (int)(1.0/TEST_LPF_K); i++)
+    {
+        output = MCAPP_FilterLPF(&filter, TEST_STEP);
+    }
+    CHECK_NEAR(output, TEST_STEP*(1.0 - exp(-1.0)), 0.01*TEST_STEP);
+    for (i = 0; i < (int)(10.0/TEST_LPF_K); i++)
+    {
+        output = MCAPP_FilterLPF(&filter, TEST_STEP);
+    }
+    CHECK_NEAR(output, TEST_STEP, 0.001*TEST_STEP + 1);
+
+    MCAPP_FilterLPFInit(&filter, Q15(0.5), -INT16_MAX);
+    previous = -INT16_MAX;
+    for (i = 0; i < 100; i++)
+    {
+        output = MCAPP_FilterLPF(&filter, INT16_MAX);
+        CHECK(output >= previous);
+        previous = output;
+    }
+    CHECK(output > INT16_MAX - 2);
+}
+
+/* Butterworth second order low pass filter settles at the step with the
+   overshoot of about 4.3% */
+static void TestLPF2(void)
+{
+    MCAPP_FILTER_LPF2_T filter;
+    int16_t output = 0;
+    int16_t peak = 0;
+    int i;
+
+    MCAPP_FilterLPF2Init(&filter, Q15(TEST_LPF2_K), TEST_LPF2_DAMPING, 0);
+    for (i = 0; i < (int)(20.0/TEST_LPF2_K); i++)
+    {
+        output = MCAPP_FilterLPF2(&filter, TEST_STEP);
+        if (output > peak)
+        {
+            peak = output;
+        }
+    }
+    CHECK(peak > TEST_STEP);
+    CHECK(peak < 1.06*TEST_STEP);
+    CHECK_NEAR(output, TEST_STEP, 0.002*TEST_STEP);
+}
+
+/* Median of three removes a single sample spike and passes a step with one
+   sample delay */
+static void TestMedian(void)
+{
+    MCAPP_FILTER_MEDIAN_T filter;
+
+    MCAPP_FilterMedianInit(&filter);
+    CHECK(MCAPP_FilterMedian(&filter, 100) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, 100) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, TEST_STEP) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, 100) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, -TEST_STEP) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, 100) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, TEST_STEP) == 100);
+    CHECK(MCAPP_FilterMedian(&filter, TEST_STEP) == TEST_STEP);
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+int main(void)
+{
+    TestAvg();
+    TestLPF();
+    TestLPF2();
+    TestMedian();
+
+    return UNIT_TEST_RESULT("test_filter");
+}
+
+// </editor-fold>
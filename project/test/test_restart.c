@@ -0,0 +1,269 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file test_restart.c
+ *
+ * @brief Host unit test of the restart policy, checks the restart delays with
+ * their back off and limit, the latched fault classes, the clearing of the
+ * consecutive restarts and the lockout after the trips within the lockout
+ * window.
+ *
+ * Component: UNIT TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+
+#include "unittest.h"
+#include "restart.h"
+#include "fault.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Control cycles per second and times in control cycles, as in restart.c */
+#define TEST_SECOND_COUNT   (uint32_t)(1.0/LOOPTIME_SEC)
+#define TEST_DELAY_COUNT(sec) (uint32_t)((sec)/LOOPTIME_SEC)
+/* Time between trips that never locks the drive out */
+#define TEST_TRIP_GAP_SEC   \
+            (FAULT_LOCKOUT_WINDOW_SEC/(FAULT_LOCKOUT_TRIPS - 1) + 1)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="VARIABLES ">
+
+/* Restart rules as configured, in the order of the fault classes */
+static const uint16_t testRestarts[FAULT_CLASS_COUNT] =
+{
+    FAULT_OVERCURRENT_RESTARTS,
+    FAULT_STALL_RESTARTS,
+    FAULT_PHASE_LOSS_RESTARTS,
+    FAULT_OVERVOLTAGE_RESTARTS,
+    FAULT_UNDERVOLTAGE_RESTARTS,
+    FAULT_HARDWARE_RESTARTS
+};
+static const double testDelaySec[FAULT_CLASS_COUNT] =
+{
+    FAULT_OVERCURRENT_RESTART_SEC,
+    FAULT_STALL_RESTART_SEC,
+    FAULT_PHASE_LOSS_RESTART_SEC,
+    FAULT_OVERVOLTAGE_RESTART_SEC,
+    FAULT_UNDERVOLTAGE_RESTART_SEC,
+    FAULT_HARDWARE_RESTART_SEC
+};
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="STATIC FUNCTIONS ">
+
+/* Runs the time base for the given seconds with the motor stopped */
+static void AdvanceSeconds(uint32_t seconds)
+{
+    uint32_t i;
+
+    for (i = 0; i < seconds*TEST_SECOND_COUNT; i++)
+    {
+        RestartStepIsr(0);
+    }
+}
+
+/* Expected delay of the restart after the given consecutive restarts */
+static uint32_t ExpectedDelay(uint16_t faultClass, uint16_t consecutive)
+{
+    uint32_t delay = TEST_DELAY_COUNT(testDelaySec[faultClass]);
+    uint16_t i;
+
+    for (i = 0; i < consecutive*FAULT_RESTART_BACKOFF_SHIFT; i++)
+    {
+        delay <<= 1;
+        if (delay >= TEST_DELAY_COUNT(FAULT_RESTART_DELAY_MAX_SEC))
+        {
+            return TEST_DELAY_COUNT(FAULT_RESTART_DELAY_MAX_SEC);
+        }
+    }
+    return delay;
+}
+
+/* Every class restarts with the backed off delays as often as its rule
+   allows and is latched on the next trip, the trips are far enough apart
+   not to lock the drive out */
+static void TestRestartDelays(void)
+{
+    uint16_t faultClass;
+    uint16_t i;
+    uint32_t delay;
+
+    for (faultClass = 0; faultClass < FAULT_CLASS_COUNT; faultClass++)
+    {
+        InitRestartParams();
+        for (i = 0; i < testRestarts[faultClass]; i++)
+        {
+            AdvanceSeconds(TEST_TRIP_GAP_SEC);
+            delay = RestartPolicy(faultClass);
+            CHECK(delay == ExpectedDelay(faultClass, i));
+            CHECK(delay <= TEST_DELAY_COUNT(FAULT_RESTART_DELAY_MAX_SEC));
+            RestartExecuted();
+        }
+        AdvanceSeconds(TEST_TRIP_GAP_SEC);
+        CHECK(RestartPolicy(faultClass) == 0);
+        CHECK(restartParm.lockout == 0);
+        CHECK(restartParm.tripCount[faultClass] ==
+                                            testRestarts[faultClass] + 1);
+        CHECK(restartParm.restartTotal == testRestarts[faultClass]);
+    }
+}
+
+/* The overcurrent and phase loss faults are not restarted, and a latched
+   fault stays latched until it is cleared by the user */
+static void TestLatchedFaults(void)
+{
+    InitRestartParams();
+    CHECK(FAULT_OVERCURRENT_RESTARTS != 0 ||
+          RestartPolicy(FAULT_CLASS_OVERCURRENT) == 0);
+    CHECK(FAULT_PHASE_LOSS_RESTARTS != 0 ||
+          RestartPolicy(FAULT_CLASS_PHASE_LOSS) == 0);
+
+    InitRestartParams();
+    if (testRestarts[FAULT_CLASS_STALL] != 0)
+    {
+        while (RestartPolicy(FAULT_CLASS_STALL) != 0)
+        {
+            AdvanceSeconds(TEST_TRIP_GAP_SEC);
+        }
+        AdvanceSeconds(TEST_TRIP_GAP_SEC);
+        CHECK(RestartPolicy(FAULT_CLASS_STALL) == 0);
+        RestartClear();
+        AdvanceSeconds(TEST_TRIP_GAP_SEC);
+        CHECK(RestartPolicy(FAULT_CLASS_STALL) ==
+                                    ExpectedDelay(FAULT_CLASS_STALL, 0));
+    }
+}
+
+/* Running without faults for FAULT_RESTART_CLEAR_SEC clears the consecutive
+   restarts, a shorter run does not */
+static void TestRunClear(void)
+{
+    uint32_t i;
+
+    InitRestartParams();
+    RestartPolicy(FAULT_CLASS_UNDERVOLTAGE);
+    for (i = 0; i < TEST_DELAY_COUNT(FAULT_RESTART_CLEAR_SEC) - 1; i++)
+    {
+        RestartStepIsr(1);
+    }
+    CHECK(restartParm.consecutive[FAULT_CLASS_UNDERVOLTAGE] == 1);
+    CHECK(RestartPolicy(FAULT_CLASS_UNDERVOLTAGE) ==
+                                ExpectedDelay(FAULT_CLASS_UNDERVOLTAGE, 1));
+
+    for (i = 0; i < TEST_DELAY_COUNT(FAULT_RESTART_CLEAR_SEC); i++)
+    {
+        RestartStepIsr(1);
+    }
+    CHECK(restartParm.consecutive[FAULT_CLASS_UNDERVOLTAGE] == 0);
+    CHECK(RestartPolicy(FAULT_CLASS_UNDERVOLTAGE) ==
+                                ExpectedDelay(FAULT_CLASS_UNDERVOLTAGE, 0));
+}
+
+/* FAULT_LOCKOUT_TRIPS trips of any class within the window lock the drive
+   out, the ring buffer of the trip times wraps around without a lockout
+   while the trips are further apart */
+static void TestLockout(void)
+{
+    uint16_t i;
+
+    InitRestartParams();
+    for (i = 0; i < 2*FAULT_LOCKOUT_TRIPS + 1; i++)
+    {
+        AdvanceSeconds(TEST_TRIP_GAP_SEC);
+        RestartPolicy(i % FAULT_CLASS_COUNT);
+        CHECK(restartParm.lockout == 0);
+        RestartClear();
+    }
+    CHECK(restartParm.lockoutTotal == 0);
+
+    /* Trips one second apart once the earlier trips are out of the window,
+       the last one of FAULT_LOCKOUT_TRIPS locks out, whatever the fault
+       classes */
+    AdvanceSeconds(FAULT_LOCKOUT_WINDOW_SEC);
+    for (i = 0; i < FAULT_LOCKOUT_TRIPS - 1; i++)
+    {
+        AdvanceSeconds(1);
+        RestartPolicy(FAULT_CLASS_UNDERVOLTAGE - (i & 1));
+        CHECK(restartParm.lockout == 0);
+        RestartClear();
+    }
+    AdvanceSeconds(1);
+    CHECK(RestartPolicy(FAULT_CLASS_UNDERVOLTAGE) == 0);
+    CHECK(restartParm.lockout == 1);
+    CHECK(restartParm.lockoutTotal == 1);
+
+    /* The user start clears the lockout, but the trip times are kept and
+       the next trip within the window locks out again */
+    RestartClear();
+    CHECK(restartParm.lockout == 0);
+    AdvanceSeconds(1);
+    CHECK(RestartPolicy(FAULT_CLASS_UNDERVOLTAGE) == 0);
+    CHECK(restartParm.lockoutTotal == 2);
+
+    /* Once the window has passed the trips restart again */
+    RestartClear();
+    AdvanceSeconds(FAULT_LOCKOUT_WINDOW_SEC);
+    CHECK(RestartPolicy(FAULT_CLASS_UNDERVOLTAGE) ==
+                                ExpectedDelay(FAULT_CLASS_UNDERVOLTAGE, 0));
+    CHECK(restartParm.lockout == 0);
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+int main(void)
+{
+    TestRestartDelays();
+    TestLatchedFaults();
+    TestRunClear();
+    TestLockout();
+
+    return UNIT_TEST_RESULT("test_restart");
+}
+
+// </editor-fold>
@@ -0,0 +1,210 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file test_speedramp.c
+ *
+ * @brief Host unit test of the S-curve speed reference, runs speed changes
+ * through SpeedRampUpdate() and checks the acceleration and jerk limits, the
+ * arrival at the target without overshoot and the profile duration.
+ *
+ * Component: UNIT TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <libq.h>
+
+#include "unittest.h"
+#include "speedramp.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Linear ramp speed change per control cycle */
+#define TEST_RAMP_RATE      ((double)SPEEDREFRAMP/(SPEEDREFRAMP_COUNT + 1))
+/* Control cycles from zero to the largest acceleration */
+#define TEST_JERK_CYCLES    (SPEED_RAMP_JERK_TIME_MSEC*0.001/LOOPTIME_SEC)
+/* Longest profile simulated, in control cycles */
+#define TEST_CYCLES_MAX     400000L
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="STATIC FUNCTIONS ">
+
+/* Runs the generator from qStart to qTarget with the acceleration limit
+   accelLimit, returns the control cycles until the target is reached with
+   zero acceleration */
+static long RunProfile(int16_t qStart, int16_t qTarget, double accelLimit)
+{
+    int16_t qVelRef = qStart;
+    int16_t qLastAccel = 0;
+    int16_t qMin = (qStart < qTarget) ? qStart : qTarget;
+    int16_t qMax = (qStart < qTarget) ? qTarget : qStart;
+    int16_t qLastVelRef;
+    long cycles = 0;
+    int monotonic = 1, inRange = 1, accelLimited = 1, jerkLimited = 1;
+    /* Acceleration change per cycle, one count for the rounding */
+    int16_t qJerkMax = (int16_t)(speedRampParm.jerk >> 15) + 1;
+    int16_t qAccelMax = (int16_t)(accelLimit*4096.0) + 1;
+
+    do
+    {
+        qLastVelRef = qVelRef;
+        qVelRef = SpeedRampUpdate(qVelRef, qTarget);
+        cycles++;
+
+        if (((qTarget > qStart) && (qVelRef < qLastVelRef)) ||
+            ((qTarget < qStart) && (qVelRef > qLastVelRef)))
+        {
+            monotonic = 0;
+        }
+        if ((qVelRef < qMin) || (qVelRef > qMax))
+        {
+            inRange = 0;
+        }
+        if ((speedRampParm.qAccel > qAccelMax) ||
+            (speedRampParm.qAccel < -qAccelMax))
+        {
+            accelLimited = 0;
+        }
+        /* The acceleration is set to zero at the target in one step */
+        if ((qVelRef != qTarget) &&
+            (_Q15abs(speedRampParm.qAccel - qLastAccel) > qJerkMax))
+        {
+            jerkLimited = 0;
+        }
+        qLastAccel = speedRampParm.qAccel;
+    } while (((qVelRef != qTarget) || (speedRampParm.qAccel != 0)) &&
+             (cycles < TEST_CYCLES_MAX));
+
+    CHECK(qVelRef == qTarget);
+    CHECK(monotonic);
+    CHECK(inRange);
+    CHECK(accelLimited);
+    CHECK(jerkLimited);
+    CHECK(speedRampParm.qAccel == 0);
+    return cycles;
+}
+
+/* Profile duration of a speed change reaching the acceleration limit, the
+   linear part plus one jerk time */
+static double ExpectedCycles(int16_t qStart, int16_t qTarget,
+                             double accelLimit)
+{
+    double delta = (double)qTarget - qStart;
+
+    if (delta < 0)
+    {
+        delta = -delta;
+    }
+    return delta/(TEST_RAMP_RATE*accelLimit) + TEST_JERK_CYCLES*accelLimit;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+int main(void)
+{
+    long cycles;
+    double expected;
+    int16_t qVelRef;
+    int i;
+
+    InitSpeedRampParams();
+
+    /* Acceleration from the end of the open loop to the nominal speed */
+    cycles = RunProfile(ENDSPEED_ELECTR, NOMINALSPEED_ELECTR, SPEED_RAMP_ACCEL);
+    expected = ExpectedCycles(ENDSPEED_ELECTR, NOMINALSPEED_ELECTR,
+                              SPEED_RAMP_ACCEL);
+    CHECK_NEAR(cycles, expected, 0.02*expected + 10);
+
+    /* Deceleration */
+    cycles = RunProfile(NOMINALSPEED_ELECTR, ENDSPEED_ELECTR, SPEED_RAMP_DECEL);
+    expected = ExpectedCycles(NOMINALSPEED_ELECTR, ENDSPEED_ELECTR,
+                              SPEED_RAMP_DECEL);
+    CHECK_NEAR(cycles, expected, 0.02*expected + 10);
+
+    /* Reversal, the deceleration limit applies down to zero speed */
+    RunProfile(NOMINALSPEED_ELECTR, -NOMINALSPEED_ELECTR,
+               (SPEED_RAMP_ACCEL > SPEED_RAMP_DECEL) ?
+                SPEED_RAMP_ACCEL : SPEED_RAMP_DECEL);
+
+    /* Small step, the acceleration limit is not reached */
+    RunProfile(NOMINALSPEED_ELECTR, NOMINALSPEED_ELECTR + 20,
+               SPEED_RAMP_ACCEL);
+
+    /* Reference set outside of the generator, it continues from there with
+       zero acceleration */
+    InitSpeedRampParams();
+    for (i = 0; i < 1000; i++)
+    {
+        qVelRef = SpeedRampUpdate(0, MAXIMUMSPEED_ELECTR);
+    }
+    qVelRef = SpeedRampUpdate(ENDSPEED_ELECTR, MAXIMUMSPEED_ELECTR);
+    CHECK(qVelRef == ENDSPEED_ELECTR);
+    CHECK(speedRampParm.qAccel <= (int16_t)(speedRampParm.jerk >> 15) + 1);
+
+    /* Time optimal scaling, reduced at the current limit down to the 
+       minimum, then recovered to full scale */
+    InitSpeedRampParams();
+    for (i = 0; i < 2000; i++)
+    {
+        SpeedRampAdapt(SPEEDCNTR_OUTMAX);
+    }
+    CHECK(speedRampParm.qAccelScale == SPEED_RAMP_SCALE_MIN);
+    cycles = RunProfile(ENDSPEED_ELECTR, ENDSPEED_ELECTR + 1000,
+                        SPEED_RAMP_ACCEL*SPEED_RAMP_SCALE_MIN/32768.0);
+    expected = ExpectedCycles(ENDSPEED_ELECTR, ENDSPEED_ELECTR + 1000,
+                        SPEED_RAMP_ACCEL*SPEED_RAMP_SCALE_MIN/32768.0);
+    CHECK_NEAR(cycles, expected, 0.02*expected + 10);
+    for (i = 0; i < 20000; i++)
+    {
+        SpeedRampAdapt(0);
+    }
+    CHECK(speedRampParm.qAccelScale == Q15(0.9999));
+
+    return UNIT_TEST_RESULT("test_speedramp");
+}
+
+// </editor-fold>
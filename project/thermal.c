@@ -0,0 +1,469 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file thermal.c
+ *
+ * @brief This module implements the thermal model of the MOSFET junction,
+ * heatsink and motor winding, the I2t overload accumulator and the derating
+ * of the current limit.
+ *
+ * Component: THERMAL PROTECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <libq.h>
+
+#include "thermal.h"
+#include "general.h"
+#include "userparms.h"
+#include "pwm.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Control cycles per model period */
+#define THERMAL_TICK_COUNT      32
+#define THERMAL_TICK_SHIFT      5
+#define THERMAL_TICK_SEC        (THERMAL_TICK_COUNT*LOOPTIME_SEC)
+/* Model periods per winding model period */
+#define THERMAL_WINDING_COUNT   512
+#define THERMAL_WINDING_SHIFT   9
+#define THERMAL_WINDING_SEC     (THERMAL_WINDING_COUNT*THERMAL_TICK_SEC)
+
+/* Load scaling, 1 << THERMAL_Q is the rated current squared */
+#define THERMAL_Q               12
+#define THERMAL_ONE             (1 << THERMAL_Q)
+/* Gain converting the squared current into the load, with 8 more fractional
+   bits, THERMAL_RATED_CURRENT must be above 0.75A */
+#define THERMAL_LOAD_GAIN       (int16_t)(THERMAL_ONE*256.0*32768.0* \
+                                    NORM_CURRENT_CONST*NORM_CURRENT_CONST/ \
+                                    (THERMAL_RATED_CURRENT* \
+                                    THERMAL_RATED_CURRENT))
+
+/* Peak and rated current in Iq reference counts */
+#define THERMAL_OVERLOAD_IQ     (int16_t)(THERMAL_OVERLOAD_CURRENT/ \
+                                    NORM_CURRENT_CONST)
+#define THERMAL_RATED_IQ        (int16_t)(THERMAL_RATED_CURRENT/ \
+                                    NORM_CURRENT_CONST)
+/* I2t budget of the overload current for THERMAL_OVERLOAD_TIME_SEC from
+   the rated load, divided by 32768 */
+#define THERMAL_I2T_SCALE       (int16_t)(THERMAL_ONE*((1.0* \
+                                    THERMAL_OVERLOAD_CURRENT* \
+                                    THERMAL_OVERLOAD_CURRENT)/ \
+                                    (THERMAL_RATED_CURRENT* \
+                                    THERMAL_RATED_CURRENT) - 1.0)* \
+                                    THERMAL_OVERLOAD_TIME_SEC/ \
+                                    THERMAL_TICK_SEC/32768.0)
+#define THERMAL_I2T_LIMIT       ((int32_t)THERMAL_I2T_SCALE*32767)
+/* I2t level where the derating starts and the gain from the level above it
+   to the derating fraction, in Q12 */
+#define THERMAL_I2T_START       Q15(THERMAL_I2T_DERATE_START)
+#define THERMAL_I2T_GAIN        (int16_t)(4096.0/(1.0 - \
+                                    THERMAL_I2T_DERATE_START))
+
+/* Temperature rises at the rated current */
+#define THERMAL_JUNCTION_RISE_RATED (int16_t)(THERMAL_JUNCTION_RISE* \
+                                    (1 << THERMAL_TEMP_Q))
+#define THERMAL_WINDING_RISE_RATED  (int16_t)(THERMAL_WINDING_RISE* \
+                                    (1 << THERMAL_TEMP_Q))
+/* Filter constants of the temperature rises */
+#define THERMAL_JUNCTION_KFILTER Q15(THERMAL_TICK_SEC/THERMAL_JUNCTION_TAU_SEC)
+#define THERMAL_WINDING_KFILTER  Q15(THERMAL_WINDING_SEC/ \
+                                    THERMAL_WINDING_TAU_SEC)
+/* Temperature limits and the gains from the temperature below the maximum
+   to the derating factor, with 8 more fractional bits */
+#define THERMAL_AMBIENT         (THERMAL_AMBIENT_TEMP << THERMAL_TEMP_Q)
+#define THERMAL_JUNCTION_MAX    (THERMAL_JUNCTION_MAX_TEMP << THERMAL_TEMP_Q)
+#define THERMAL_JUNCTION_GAIN   (int16_t)(32768.0*256.0/ \
+                                    ((THERMAL_JUNCTION_MAX_TEMP - \
+                                    THERMAL_JUNCTION_DERATE_TEMP)* \
+                                    (1 << THERMAL_TEMP_Q)))
+#define THERMAL_WINDING_MAX     (THERMAL_WINDING_MAX_TEMP << THERMAL_TEMP_Q)
+#define THERMAL_WINDING_GAIN    (int16_t)(32768.0*256.0/ \
+                                    ((THERMAL_WINDING_MAX_TEMP - \
+                                    THERMAL_WINDING_DERATE_TEMP)* \
+                                    (1 << THERMAL_TEMP_Q)))
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES">
+THERMAL_PARM_T thermalParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+static void ThermalUpdateWinding(void);
+static int16_t ThermalDerateFactor(int16_t temperature, int16_t maxTemperature,
+                                   int16_t gain);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    InitThermalParams()
+
+  Summary:
+    Initializes thermal protection parameters
+
+  Description:
+    This routine initializes the thermal model with all temperatures at
+    THERMAL_AMBIENT_TEMP, an empty I2t accumulator and the current limit at
+    THERMAL_OVERLOAD_CURRENT.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    Called once at power up, the model keeps running while the motor is
+    stopped so that the temperatures decay. A winding still hot from before
+    a reset is not known to the model.
+ */
+void InitThermalParams(void)
+{
+    thermalParm.i2Sum = 0;
+    thermalParm.tickCount = 0;
+    thermalParm.qLoad = 0;
+    thermalParm.i2tAccum = 0;
+    thermalParm.qI2tLevel = 0;
+    thermalParm.heatsinkTemp = THERMAL_AMBIENT;
+    thermalParm.junctionRise = 0;
+    thermalParm.junctionStateVar = 0;
+    thermalParm.junctionTemp = THERMAL_AMBIENT;
+    thermalParm.windingLoadSum = 0;
+    thermalParm.windingTickCount = 0;
+    thermalParm.windingRise = 0;
+    thermalParm.windingStateVar = 0;
+    thermalParm.windingTemp = THERMAL_AMBIENT;
+    thermalParm.qIqLimit = THERMAL_OVERLOAD_IQ;
+}
+// *****************************************************************************
+
+/* Function:
+    ThermalAccumulate()
+
+  Summary:
+    Accumulates the squared current magnitude
+
+  Description:
+    The squared magnitude of the d-q currents, the source of the conduction
+    losses in the MOSFETs and in the winding, is added to the sum of the
+    model period.
+
+  Precondition:
+    Called once every control cycle while the motor runs.
+
+  Parameters:
+    pIdq - pointer to the d-q currents
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+void ThermalAccumulate(const MC_DQ_T *pIdq)
+{
+    thermalParm.i2Sum += (__builtin_mulss(pIdq->d, pIdq->d) +
+                          __builtin_mulss(pIdq->q, pIdq->q)) >> 15;
+}
+// *****************************************************************************
+
+/* Function:
+    ThermalStepIsr()
+
+  Summary:
+    Executes the thermal model and updates the current limit
+
+  Description:
+    Every THERMAL_TICK_COUNT control cycles the mean squared current is
+    converted into the load, the squared current relative to the rated
+    current.
+    I2t - the load above the rated load is integrated and the integral
+    decreases again below it. Above THERMAL_I2T_DERATE_START of the budget
+    of THERMAL_OVERLOAD_CURRENT for THERMAL_OVERLOAD_TIME_SEC the current
+    limit is reduced linearly to THERMAL_RATED_CURRENT, where the integral
+    stops rising.
+    Junction - the junction rises above the measured heatsink temperature
+    by THERMAL_JUNCTION_RISE times the load, with the time constant
+    THERMAL_JUNCTION_TAU_SEC.
+    Winding - the winding rises above THERMAL_AMBIENT_TEMP by
+    THERMAL_WINDING_RISE times the load, with the time constant
+    THERMAL_WINDING_TAU_SEC.
+    Above the derating temperature of the junction or the winding the
+    current limit is reduced linearly to zero at the maximum temperature.
+
+  Precondition:
+    Called once every control cycle.
+
+  Parameters:
+    temperature - heatsink temperature in degrees Celsius
+
+  Returns:
+    None.
+
+  Remarks:
+    The derating factors are continuous functions of the model states, so
+    the current limit changes smoothly.
+ */
+void ThermalStepIsr(int16_t temperature)
+{
+    int32_t i2, limit;
+    int16_t factor, tempint;
+
+    thermalParm.tickCount++;
+    if (thermalParm.tickCount < THERMAL_TICK_COUNT)
+    {
+        return;
+    }
+    thermalParm.tickCount = 0;
+
+    /* Load from the mean squared current */
+    i2 = thermalParm.i2Sum >> THERMAL_TICK_SHIFT;
+    thermalParm.i2Sum = 0;
+    if (i2 > Q15(0.9999))
+    {
+        i2 = Q15(0.9999);
+    }
+    i2 = __builtin_mulss((int16_t)i2, THERMAL_LOAD_GAIN) >> 8;
+    if (i2 > Q15(0.9999))
+    {
+        i2 = Q15(0.9999);
+    }
+    thermalParm.qLoad = (int16_t)i2;
+
+    /* I2t accumulator */
+    thermalParm.i2tAccum += thermalParm.qLoad - THERMAL_ONE;
+    if (thermalParm.i2tAccum < 0)
+    {
+        thermalParm.i2tAccum = 0;
+    }
+    else if (thermalParm.i2tAccum > THERMAL_I2T_LIMIT)
+    {
+        thermalParm.i2tAccum = THERMAL_I2T_LIMIT;
+    }
+    thermalParm.qI2tLevel = __builtin_divsd(thermalParm.i2tAccum,
+                                            THERMAL_I2T_SCALE);
+
+    /* Junction above the heatsink */
+    thermalParm.heatsinkTemp = temperature << THERMAL_TEMP_Q;
+    tempint = (int16_t)(__builtin_mulss(thermalParm.qLoad,
+                            THERMAL_JUNCTION_RISE_RATED) >> THERMAL_Q);
+    thermalParm.junctionStateVar += __builtin_mulss((int16_t)(tempint -
+                thermalParm.junctionRise), THERMAL_JUNCTION_KFILTER);
+    thermalParm.junctionRise = (int16_t)(thermalParm.junctionStateVar >> 15);
+    thermalParm.junctionTemp = thermalParm.heatsinkTemp +
+                                                    thermalParm.junctionRise;
+
+    /* Winding above the ambient */
+    thermalParm.windingLoadSum += thermalParm.qLoad;
+    thermalParm.windingTickCount++;
+    if (thermalParm.windingTickCount >= THERMAL_WINDING_COUNT)
+    {
+        ThermalUpdateWinding();
+    }
+
+    /* Current limit from the I2t accumulator */
+    limit = THERMAL_OVERLOAD_IQ;
+    if (thermalParm.qI2tLevel > THERMAL_I2T_START)
+    {
+        i2 = __builtin_mulss((int16_t)(thermalParm.qI2tLevel -
+                                THERMAL_I2T_START), THERMAL_I2T_GAIN) >> 12;
+        if (i2 > Q15(0.9999))
+        {
+            i2 = Q15(0.9999);
+        }
+        limit -= __builtin_mulss(THERMAL_OVERLOAD_IQ - THERMAL_RATED_IQ,
+                                 (int16_t)i2) >> 15;
+    }
+
+    /* Current limit from the temperatures */
+    factor = ThermalDerateFactor(thermalParm.junctionTemp,
+                                 THERMAL_JUNCTION_MAX, THERMAL_JUNCTION_GAIN);
+    tempint = ThermalDerateFactor(thermalParm.windingTemp,
+                                  THERMAL_WINDING_MAX, THERMAL_WINDING_GAIN);
+    if (tempint < factor)
+    {
+        factor = tempint;
+    }
+    i2 = __builtin_mulss(THERMAL_OVERLOAD_IQ, factor) >> 15;
+    if (i2 < limit)
+    {
+        limit = i2;
+    }
+    thermalParm.qIqLimit = (int16_t)limit;
+}
+// *****************************************************************************
+
+/* Function:
+    ThermalLimit()
+
+  Summary:
+    Limits the Iq reference to the thermal current limit
+
+  Description:
+    The Iq reference is limited to +/- thermalParm.qIqLimit.
+
+  Precondition:
+    None.
+
+  Parameters:
+    qIqRef - Iq reference
+
+  Returns:
+    Limited Iq reference.
+
+  Remarks:
+    The speed controller output is limited by its outMax already, the Iq
+    reference is limited again after the feed forward and shaping terms and
+    in torque mode.
+ */
+int16_t ThermalLimit(int16_t qIqRef)
+{
+    if (qIqRef > thermalParm.qIqLimit)
+    {
+        qIqRef = thermalParm.qIqLimit;
+    }
+    else if (qIqRef < -thermalParm.qIqLimit)
+    {
+        qIqRef = -thermalParm.qIqLimit;
+    }
+    return qIqRef;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+// *****************************************************************************
+
+/* Function:
+    ThermalUpdateWinding()
+
+  Summary:
+    Updates the winding temperature
+
+  Description:
+    The winding time constant is minutes, its first order model is updated
+    with the mean load of THERMAL_WINDING_COUNT model periods so that the
+    filter constant keeps its resolution in Q15.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+ */
+static void ThermalUpdateWinding(void)
+{
+    int16_t load, rise;
+
+    load = (int16_t)(thermalParm.windingLoadSum >> THERMAL_WINDING_SHIFT);
+    thermalParm.windingLoadSum = 0;
+    thermalParm.windingTickCount = 0;
+
+    rise = (int16_t)(__builtin_mulss(load, THERMAL_WINDING_RISE_RATED) >>
+                                                                THERMAL_Q);
+    thermalParm.windingStateVar += __builtin_mulss((int16_t)(rise -
+                thermalParm.windingRise), THERMAL_WINDING_KFILTER);
+    thermalParm.windingRise = (int16_t)(thermalParm.windingStateVar >> 15);
+    thermalParm.windingTemp = THERMAL_AMBIENT + thermalParm.windingRise;
+}
+// *****************************************************************************
+
+/* Function:
+    ThermalDerateFactor()
+
+  Summary:
+    Calculates the derating factor for a temperature
+
+  Description:
+    The factor decreases linearly from 1 at the derating temperature to 0 at
+    the maximum temperature.
+
+  Precondition:
+    None.
+
+  Parameters:
+    temperature - temperature
+    maxTemperature - maximum temperature
+    gain - gain from the temperature below the maximum to the factor, with
+           8 more fractional bits
+
+  Returns:
+    Derating factor in Q15.
+
+  Remarks:
+    None.
+ */
+static int16_t ThermalDerateFactor(int16_t temperature, int16_t maxTemperature,
+                                   int16_t gain)
+{
+    int32_t factor = (int32_t)maxTemperature - temperature;
+
+    if (factor <= 0)
+    {
+        return 0;
+    }
+    if (factor > Q15(0.9999))
+    {
+        factor = Q15(0.9999);
+    }
+    factor = __builtin_mulss((int16_t)factor, gain) >> 8;
+    if (factor > Q15(0.9999))
+    {
+        factor = Q15(0.9999);
+    }
+    return (int16_t)factor;
+}
+
+// </editor-fold>
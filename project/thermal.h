@@ -0,0 +1,124 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file thermal.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the thermal model and of the current derating
+ *
+ * Component: THERMAL PROTECTION
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef __THERMAL_H
+#define __THERMAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+
+#include "motor_control_noinline.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
+/* Temperatures are given in degrees Celsius multiplied by 2^THERMAL_TEMP_Q */
+#define THERMAL_TEMP_Q          4
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPES ">
+/* Thermal Protection Parameter data type
+
+  Description:
+    This structure will host parameters related to the thermal model of the
+    MOSFET junction, heatsink and motor winding, to the I2t overload
+    accumulator and to the resulting current limit.
+ */
+typedef struct
+{
+    /* Sum of the squared current magnitude over the model period */
+    int32_t i2Sum;
+    /* Control cycles in the model period */
+    uint16_t tickCount;
+    /* Squared current relative to the rated current, in Q12 */
+    int16_t qLoad;
+    /* I2t accumulator, squared current above the rated current */
+    int32_t i2tAccum;
+    /* I2t accumulator relative to the overload budget */
+    int16_t qI2tLevel;
+    /* Heatsink temperature measured by the MOSFET temperature sensor */
+    int16_t heatsinkTemp;
+    /* Junction temperature rise above the heatsink */
+    int16_t junctionRise;
+    /* State variable for the junction temperature rise */
+    int32_t junctionStateVar;
+    /* Junction temperature */
+    int16_t junctionTemp;
+    /* Sum of the load over the winding model period */
+    int32_t windingLoadSum;
+    /* Model periods in the winding model period */
+    uint16_t windingTickCount;
+    /* Winding temperature rise above the ambient */
+    int16_t windingRise;
+    /* State variable for the winding temperature rise */
+    int32_t windingStateVar;
+    /* Winding temperature */
+    int16_t windingTemp;
+    /* Iq limit from the I2t accumulator and the temperatures */
+    int16_t qIqLimit;
+} THERMAL_PARM_T;
+
+extern THERMAL_PARM_T thermalParm;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS">
+void InitThermalParams(void);
+void ThermalAccumulate(const MC_DQ_T *pIdq);
+void ThermalStepIsr(int16_t temperature);
+int16_t ThermalLimit(int16_t qIqRef);
+
+// </editor-fold>
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __THERMAL_H */
@@ -84,13 +84,255 @@ constant slope. The slope is determined by TUNING_DELAY_RAMPUP constant.
 /* closed loop transition disabled  */
 #undef OPEN_LOOP_FUNCTIONING
 
-/* Definition for torque mode - for a separate tuning of the current PI
-controllers, tuning mode will disable the speed PI controller */
-#undef TORQUE_MODE
+/* Control mode at power up, CTRL_MODE_SPEED, CTRL_MODE_TORQUE or 
+CTRL_MODE_SPEED_LIMITED_TORQUE. The mode and the torque reference in 
+CTRL_MODE_TORQUE_UNIT_NM units are changed at run time in ctrlModeParm.request
+and ctrlModeParm.torqueRef, the change is made without a step of the q current
+reference. Torque control disables the speed PI controller, for a separate 
+tuning of the current PI controllers */
+#define CTRL_MODE_DEFAULT CTRL_MODE_SPEED
+
+/* Definition for speed controller gain scheduling - if defined, the speed 
+controller gains are interpolated from a table over the speed range and 
+multiplied by the load inertia, estimated from the Iq reference during the 
+speed reference ramps. The current accelerating the estimated inertia at the
+ramp rate is fed forward to the Iq reference. This gives the same speed 
+response for loads with different inertia */
+#undef SPEED_GAIN_SCHEDULING
+
+/* Definition for S-curve speed reference - if defined, the linear speed 
+reference ramp is replaced by a generator with limited acceleration and jerk,
+with separate acceleration limits for increasing and decreasing speed. The 
+smooth start and end of the acceleration avoid exciting mechanical resonances
+and the current overshoot of the linear ramp */
+#undef SPEED_REF_SCURVE
+
+/* Definition for time optimal S-curve - if defined, the acceleration limits
+of the S-curve generator are the largest allowed and are reduced while the 
+Iq reference exceeds SPEED_RAMP_CURRENT_LIMIT, so that the target speed is 
+reached as fast as the current limit allows */
+#undef SPEED_RAMP_TIME_OPTIMAL
+
+/* Definition for resonance notch filter - if defined, the speed controller 
+output is filtered with NOTCH_FILTER_COUNT notch filters, so that the speed 
+controller does not excite a mechanical resonance of the drive train */
+#undef RESONANCE_NOTCH_FILTER
+
+/* Definition for adaptive notch filter - if defined, the resonance frequency
+is detected in the Iq current with Goertzel filters between 
+NOTCH_DETECT_MIN_HZ and NOTCH_DETECT_MAX_HZ, and the first notch filter is 
+tuned to it */
+#undef NOTCH_ADAPTIVE
+
+#if defined(NOTCH_ADAPTIVE) && !defined(RESONANCE_NOTCH_FILTER)
+    #error "NOTCH_ADAPTIVE requires RESONANCE_NOTCH_FILTER"
+#endif
+
+#if defined(SPEED_RAMP_TIME_OPTIMAL) && !defined(SPEED_REF_SCURVE)
+    #error "SPEED_RAMP_TIME_OPTIMAL requires SPEED_REF_SCURVE"
+#endif
+
+/* Definition for flying start - if defined, the rotor is first driven with
+zero current control so that the estimator locks to the BEMF of a rotor that
+is already spinning. A rotor spinning forward is caught directly in closed 
+loop. A rotor spinning in reverse is decelerated in closed loop down to the 
+minimum catch speed, then left to coast with zero current for 
+FLYING_START_COAST_TIME and caught again. A rotor below the minimum catch 
+speed falls back to the open loop start up */
+#undef FLYING_START
+
+/* Definition for initial position detection - if defined, the rotor angle at
+standstill is detected from the current response to short voltage pulses 
+applied along a set of test angles, and the open loop start up begins from the
+detected angle without the lock sequence. The detection relies on magnetic
+saliency or saturation of the motor, check the result on the target motor
+before enabling it */
+#undef INITIAL_POSITION_DETECTION
+
+/* Definition for low speed high frequency injection - if defined, a square 
+wave voltage is injected on the estimated d-axis at half the PWM frequency and
+the rotor angle is tracked from the saliency of the motor (Ld < Lq), so the 
+drive starts directly in closed loop and controls torque down to standstill.
+The angle is cross faded into the BEMF estimator between HFI_BLEND_START_RPM 
+and HFI_BLEND_END_RPM. The injection does not resolve the rotor polarity,
+initial position detection must be enabled as well */
+#undef LOW_SPEED_HFI
+
+/* Definition for ISR cycle measurement - if defined, Timer1 counts instruction
+cycles and the execution time of each stage of the ADC ISR is stored in 
+isrCycles, to be read with X2CScope */
+#undef ISR_CYCLE_MEASUREMENT
+
+/* Definition for current controller decoupling - if defined, the cross 
+coupling voltages omega*Ls*Id, omega*Ls*Iq and the BEMF voltage are calculated
+from the estimated speed and the estimator motor parameters and are added to 
+the outputs of the d-q current controllers in closed loop. This improves the 
+current response at high speed, where these terms dominate */
+#undef CURRENT_DECOUPLING
+
+/* Definition for overmodulation - if defined, the voltage base is the 
+six-step fundamental voltage instead of the limit of the linear space vector
+modulation, and the modulation stage continues beyond the linear range with
+two region overmodulation up to six-step. This gives about 10% more 
+fundamental voltage at the price of low order current harmonics. The 
+normalized motor parameters are rescaled to the voltage base below */
+#undef OVERMODULATION
+
+/* Definition for dead time compensation - if defined, the voltage lost in 
+each inverter leg during the dead time and across the power devices is added 
+to the modulator input in the direction of the phase current. The sign of the
+current is linear within a band around zero, so that the compensation does 
+not toggle on the current ripple at the zero crossings */
+#undef DEADTIME_COMPENSATION
+
+/* Definition for discontinuous PWM - if defined, above a modulation index 
+threshold one inverter leg is clamped to the duty cycle limit for part of 
+the electrical period (DPWM_SELECTED_MODE), which removes one third of the 
+switching events and the related inverter losses. Below the threshold the 
+continuous space vector modulation is used. With single shunt no leg is 
+clamped while the measurement windows need an edge shift */
+#undef DISCONTINUOUS_PWM
+
+/* Definition for DC bus voltage compensation - if defined, the modulator 
+input is multiplied by the ratio of the nominal to the measured DC bus 
+voltage, so that the applied voltage follows the references for bus voltages
+other than DC_BUS_VOLTAGE_NOMINAL. The reciprocal is calculated without 
+division from the filtered bus voltage, and the 100Hz rectifier ripple is fed
+forward from the unfiltered measurement */
+#undef DC_BUS_COMPENSATION
+
+/* Definition for DC link ripple shaping - if defined, for inverters with a 
+small film capacitor in the DC link, the Iq reference is weighted with the 
+square of the bus voltage relative to its mean, so that the mains current 
+follows the mains voltage instead of flowing in short peaks. The small 
+capacitor cannot absorb braking energy, the regenerative current is limited 
+by the controlled stop between BRAKE_REGEN_LIMIT_START and 
+BRAKE_REGEN_LIMIT_END */
+#undef DC_LINK_RIPPLE_SHAPING
+
+#if defined(DC_LINK_RIPPLE_SHAPING) && !defined(DC_BUS_COMPENSATION)
+    #error "DC_LINK_RIPPLE_SHAPING requires DC_BUS_COMPENSATION"
+#endif
+
+/* Definition for measurement input filtering - if defined, the potentiometer
+is filtered with a median of three and a 16 sample moving average, and the 
+DC bus voltage with a median of three and a 20Hz second order low pass 
+filter. Otherwise both are the last sample, the median of the DC bus voltage
+is always calculated for the protections */
+#undef MEASURE_INPUT_FILTER
+
+/* Definition for thermal protection - if defined, the MOSFET junction and 
+motor winding temperatures are estimated from the current and the measured
+heatsink temperature, and an I2t accumulator allows THERMAL_OVERLOAD_CURRENT
+for THERMAL_OVERLOAD_TIME_SEC. The speed controller output limit is reduced 
+smoothly to THERMAL_RATED_CURRENT when the overload budget is used up, and 
+to zero when a temperature approaches its maximum */
+#undef THERMAL_PROTECTION
+
+/* Definition for fault detection - if defined, overcurrent, stall, phase loss
+and DC bus over and under voltage are detected in software every control 
+cycle, in addition to the hardware overcurrent comparator. Each fault stops 
+the motor with its configured reaction: coast with the PWM outputs disabled,
+brake on the low side switches. The motor is then restarted by the restart 
+policy, with a number of restarts and a backoff delay for each fault class,
+and locked out after repeated trips until it is started by the user */
+#undef FAULT_DETECTION
+
+/* Definition for controlled stop - if defined, the stop button ramps the 
+speed reference down in BRAKE_DECEL_TIME_SEC from the maximum speed and ends
+with a short circuit or DC injection brake, so that the stop time is bounded.
+The regenerative current is reduced to zero between BRAKE_REGEN_LIMIT_START 
+and BRAKE_REGEN_LIMIT_END of the bus voltage while the motor runs */
+#undef CONTROLLED_STOP
+
+/* Definition for brake chopper - if defined, BRAKE_CHOPPER_OUTPUT switches a
+brake resistor across the DC bus above BRAKE_CHOPPER_ON */
+#undef BRAKE_CHOPPER
+
+#if defined(BRAKE_CHOPPER) && !defined(CONTROLLED_STOP)
+    #error "BRAKE_CHOPPER requires CONTROLLED_STOP"
+#endif
+#if defined(DC_LINK_RIPPLE_SHAPING) && !defined(CONTROLLED_STOP)
+    #error "DC_LINK_RIPPLE_SHAPING requires CONTROLLED_STOP"
+#endif
+
+/* Definition for maximum torque per ampere - if defined, for interior 
+permanent magnet motors (Ld < Lq) the d current reference is calculated from 
+the q current reference with MOTOR_LD, MOTOR_LQ and MOTOR_FLUX_LINKAGE, 
+instead of zero. Above MTPA_FW_VOLTAGE of the output voltage the d current is
+made more negative by an integral controller to weaken the field, down to the
+characteristic current psi/Ld, MTPA_FW_CURRENT_MAX or the current limit, and 
+the q current is limited to the current left within the current limit. The 
+estimator parameter NORM_LSDTBASE must be calculated with Lq, the inverse 
+flux constant is corrected for the reluctance flux (Lq - Ld)*Id */
+#undef MTPA
+
+/* Definition for efficiency optimization - if defined, at light load and 
+steady speed an offset is added to the d current reference and searched by 
+perturb and observe for the lowest electrical input power vd*id + vq*iq. The
+offset is stepped by EFFICIENCY_ID_STEP every settling time and power window,
+kept in the direction in which the power decreases, and the offset with the 
+lowest power is held after EFFICIENCY_REVERSALS reversals until the speed 
+reference changes. Above EFFICIENCY_LOAD_CURRENT the offset is removed */
+#undef EFFICIENCY_OPTIMIZATION
+
+/* Definition for power metering - if defined, the electrical power at the 
+motor terminals, the input power from the DC bus and the electromagnetic 
+torque are calculated every PWM period and filtered, and the energy taken 
+from and returned to the DC bus is counted in watt hours, to be read with 
+X2CScope in meterParm. The bases of the normalized values in watts and newton 
+meters are METER_POWER_BASE_W and METER_TORQUE_BASE_NM in meter.h */
+#undef POWER_METERING
+
+#if defined(LOW_SPEED_HFI) && !defined(INITIAL_POSITION_DETECTION)
+    #error "LOW_SPEED_HFI requires INITIAL_POSITION_DETECTION"
+#endif
     
 /* undef to work with dual Shunt  */    
 #define SINGLE_SHUNT     
 
+/* Definition for single shunt minimum distortion windows - if defined, the 
+edge shift opening the current measurement windows is shared by the three 
+legs instead of moving a single edge by the full window deficit. This halves
+the largest asymmetry of the PWM pattern, reducing current ripple and noise 
+at low modulation and in the sector transitions. Undefined by default until 
+its current THD is measured against the single edge shift */
+#undef SINGLE_SHUNT_MIN_DISTORTION
+
+/* Definition for single shunt current prediction - if defined, the phase 
+currents are also predicted from the motor model (Rs, Ls, applied voltage and
+estimated BEMF), and each reconstructed phase current is blended with its 
+prediction according to the validity of its bus current sample. Samples from
+windows shorter than SSTSETTLEINSEC are only partly trusted, which allows a 
+shorter SSTCRITINSEC and less pattern distortion */
+#undef SINGLE_SHUNT_PREDICTION
+
+/* Definition for current offset tracking - if defined, the current offsets 
+are tracked continuously with a slow, slew limited filter whenever the motor
+is stopped and the PWM outputs are off, instead of being measured once over 
+OFFSET_COUNT_MAX samples after every stop. After the motor ran, tracking 
+resumes CURRENT_OFFSET_COAST_TIME_SEC after the outputs are disabled, when 
+the rotor is at standstill. The offsets are valid a few 
+milliseconds after reset and their drift is available for monitoring in 
+measureInputs.current.driftIa/driftIb/driftIbus */
+#undef CURRENT_OFFSET_TRACKING
+
+/* Definition for ADC oversampling - if defined with dual shunt, each phase 
+current is converted twice per PWM period, at ADC_SAMPLING_POINT and 
+ADC_OVERSAMPLING_SPACING_MICROSEC later, and the two conversions are 
+accumulated by the ADC digital filters into one 13-bit result. The 
+decimation is done by the ADC hardware, the ISR reads a single result and 
+converts it to the signed fractional scale of the 12-bit results */
+#undef ADC_OVERSAMPLING
+
+#if defined(ADC_OVERSAMPLING) && defined(SINGLE_SHUNT)
+    #error "ADC_OVERSAMPLING is not supported with SINGLE_SHUNT"
+#endif
+
+#if defined(SINGLE_SHUNT_PREDICTION) && !defined(SINGLE_SHUNT)
+    #error "SINGLE_SHUNT_PREDICTION requires SINGLE_SHUNT"
+#endif
+
 /* undef to work with External Op-Amp*/
 #define INTERNAL_OPAMP_CONFIG    
 
@@ -135,6 +377,26 @@ controllers, tuning mode will disable the speed PI controller */
    normalized dt value */
 #define NORM_DELTAT  1790
 
+/* With overmodulation the normalized motor parameters given above for the 
+ linear modulation limit are rescaled to the six-step voltage base */
+#ifdef OVERMODULATION
+#define NORM_VOLTAGE_BASE_RATIO 0.9069
+#else
+#define NORM_VOLTAGE_BASE_RATIO 1.0
+#endif
+/* Normalized parameter proportional to the voltage base */
+#define NORM_VOLTAGE_SCALE(x) (int16_t)((x)*NORM_VOLTAGE_BASE_RATIO)
+/* Normalized parameter inversely proportional to the voltage base */
+#define NORM_VOLTAGE_INV_SCALE(x) (int16_t)((x)/NORM_VOLTAGE_BASE_RATIO)
+
+/* Magnet flux linkage in volt seconds per electrical radian, from the 
+ estimator speed calculation omega = InvKFi*Es, and torque constant in newton
+ meters per amp of peak phase current */
+#define NORM_FLUX_LINKAGE (DC_BUS_VOLTAGE_NOMINAL/1.7320508*60.0/ \
+                           (6.2831853*NORM_INVKFIBASE* \
+                           (1 << NORM_INVKFIBASE_SCALE)))
+#define MOTOR_TORQUE_CONSTANT (1.5*POLE_PAIRS*NORM_FLUX_LINKAGE)
+
 /* Limitation constants */
 /* di = i(t1)-i(t2) limitation
  high speed limitation, for dt 50us 
@@ -181,8 +443,260 @@ before the open loop speed ramp up */
 /* Open loop q current setup - */
 #define Q_CURRENT_REF_OPENLOOP NORM_CURRENT(0.5)
 
+/* Flying start constants */
+/* Duration of zero current control used to lock the estimator to the BEMF of
+ a spinning rotor. This number is: 20,000 is 1 second. */
+#define FLYING_START_TIME 400
+/* Minimum speed in RPM at which a spinning rotor is caught in closed loop,
+ below this speed the open loop start up sequence is used. The estimator is 
+ valid from END_SPEED_RPM */
+#define FLYING_START_MIN_SPEED_RPM END_SPEED_RPM
+/* Duration of zero current control after a reverse rotor was decelerated to
+ the minimum catch speed, longer than the time the load takes to coast to 
+ standstill from there. This number is: 20,000 is 1 second. */
+#define FLYING_START_COAST_TIME 40000
+/* Minimum catch speed converted into electrical speed */
+#define FLYING_START_MIN_SPEED_ELECTR FLYING_START_MIN_SPEED_RPM*POLE_PAIRS
+#if FLYING_START_MIN_SPEED_RPM < END_SPEED_RPM
+    #error "FLYING_START_MIN_SPEED_RPM must not be below END_SPEED_RPM"
+#endif
+
+/* Initial position detection constants */
+/* Amplitude of the voltage pulses, fraction of the maximum voltage vector */
+#define IPD_VOLTAGE Q15(0.15)
+/* Duration of each voltage pulse in ADC ISR cycles(the current is returned
+ to zero by a negative pulse of the same duration) */
+#define IPD_PULSE_TIME 4
+/* Time allowed for the current to decay between test angles in ADC ISR cycles */
+#define IPD_REST_TIME 20
+
+/* High frequency injection constants */
+/* Amplitude of the injected square wave voltage, fraction of the maximum 
+ voltage vector */
+#define HFI_VOLTAGE Q15(0.05)
+/* Tracking PLL gains, the PLL output is scaled down by 2^HFI_PLL_SCALE */
+#define HFI_PLL_SCALE 10
+#define HFI_PLL_PTERM 8000
+#define HFI_PLL_ITERM 200
+/* Limit of the tracking PLL integrator */
+#define HFI_PLL_OMEGA_MAX ((int32_t)MAXIMUMSPEED_ELECTR << HFI_PLL_SCALE)
+/* Speed range in RPM over which the angle is cross faded from the injection
+ estimate to the BEMF estimator, starting where the BEMF estimator is valid */
+#define HFI_BLEND_START_RPM END_SPEED_RPM
+#define HFI_BLEND_END_RPM (END_SPEED_RPM + 300)
+/* Blending start speed converted into electrical speed */
+#define HFI_BLEND_START_ELECTR HFI_BLEND_START_RPM*POLE_PAIRS
+/* Weight increase per electrical speed unit above the blending start speed */
+#define HFI_BLEND_GAIN (32767/((HFI_BLEND_END_RPM-HFI_BLEND_START_RPM)*POLE_PAIRS))
+#if HFI_BLEND_START_RPM < END_SPEED_RPM
+    #error "HFI_BLEND_START_RPM must not be below END_SPEED_RPM"
+#endif
+
+/* Current controller decoupling constants */
+/* Limit of the feed forward voltages, fraction of the maximum voltage vector */
+#define DECOUPLING_VOLTAGE_MAX Q15(0.9)
+
+/* Dead time compensation constants */
+/* Voltage drop of the power devices, added to the dead time voltage error */
+#define DEADTIME_COMP_DEVICE_DROP Q15(0.005)
+/* Current band around zero crossing where the compensation is linear */
+#define DEADTIME_COMP_CURRENT_BAND NORM_CURRENT(0.1)
+
+/* Discontinuous PWM constants */
+/* Discontinuous variant: DPWM_MIN, DPWM_MAX or DPWM_1 */
+#define DPWM_SELECTED_MODE DPWM_1
+/* Voltage amplitude enabling the discontinuous PWM, fraction of the voltage
+   base */
+#define DPWM_MODULATION_THRESHOLD Q15(0.7)
+/* Hysteresis of the voltage amplitude for returning to continuous PWM */
+#define DPWM_MODULATION_HYSTERESIS Q15(0.05)
+/* Low side on time kept for sampling the phase current shunts */
+#define DPWM_SAMPLE_WINDOW_MICROSEC 2.0
+
+/* Current offset tracking constants */
+/* Time after the PWM outputs are disabled until the offsets are tracked, 
+   longer than the coast down of the rotor from the maximum speed, in 
+   seconds, at most 3.2. A coasting rotor drives current through the body 
+   diodes when its BEMF exceeds the bus voltage */
+#define CURRENT_OFFSET_COAST_TIME_SEC 3.0
+
+/* DC bus voltage compensation constants */
+/* Bus voltage for which the motor parameters are normalized, in volts */
+#define DC_BUS_VOLTAGE_NOMINAL 310.0
+/* Bus voltage at the full scale of the ADC input, in volts, given by the 
+   voltage divider of the development board */
+#define DC_BUS_VOLTAGE_FULL_SCALE 453.6
+/* Cut off frequency of the bus voltage filter, below the rectifier ripple */
+#define DC_BUS_FILTER_CUTOFF_HZ 10.0
+/* Limits of the compensation gain, for bus voltages from half to twice the 
+   nominal bus voltage */
+#define DC_BUS_COMP_GAIN_MIN 0.5
+#define DC_BUS_COMP_GAIN_MAX 1.9998
+
+/* Thermal protection constants */
+/* Peak current allowed for short overloads in amps, must be within the peak
+   current rating of the motor and the inverter */
+#define THERMAL_OVERLOAD_CURRENT     6
+/* Peak current allowed continuously in amps */
+#define THERMAL_RATED_CURRENT        MOTOR_RATED_PEAK_CURRENT
+/* Time the overload current can be supplied after running at the rated 
+   current, up to 100 seconds for twice the rated current */
+#define THERMAL_OVERLOAD_TIME_SEC    10.0
+/* Fraction of the overload budget where the derating starts */
+#define THERMAL_I2T_DERATE_START     0.75
+/* MOSFET junction temperature rise above the heatsink at the rated current,
+   its time constant and the temperatures where the derating starts and the
+   current reaches zero, in degrees Celsius */
+#define THERMAL_JUNCTION_RISE        10.0
+#define THERMAL_JUNCTION_TAU_SEC     0.1
+#define THERMAL_JUNCTION_DERATE_TEMP 110
+#define THERMAL_JUNCTION_MAX_TEMP    150
+/* Ambient temperature of the motor, winding temperature rise at the rated 
+   current, its time constant and the temperatures where the derating starts
+   and the current reaches zero, in degrees Celsius. The derating ranges 
+   must be at least 16 degrees Celsius */
+#define THERMAL_AMBIENT_TEMP         40
+#define THERMAL_WINDING_RISE         80.0
+#define THERMAL_WINDING_TAU_SEC      600.0
+#define THERMAL_WINDING_DERATE_TEMP  130
+#define THERMAL_WINDING_MAX_TEMP     155
+
+/* Fault detection constants */
+/* Overcurrent level, fraction of Q15_OVER_CURRENT_THRESHOLD, and the number
+   of consecutive control cycles above it */
+#define FAULT_OVERCURRENT_LEVEL      0.95
+#define FAULT_OVERCURRENT_COUNT      8
+/* Phase loss - ratio of the largest to the smallest mean squared phase 
+   current, minimum peak current of the largest phase in amps and the number
+   of consecutive windows of 51.2ms */
+#define FAULT_PHASE_LOSS_RATIO       8
+#define FAULT_PHASE_LOSS_CURRENT     0.3
+#define FAULT_PHASE_LOSS_WINDOWS     3
+/* Stall - allowed difference between the estimated speed and the speed from
+   the BEMF magnitude, fraction of the estimated speed, and the time with the
+   speed controller saturated, up to 3 seconds */
+#define FAULT_STALL_SPEED_ERROR      0.25
+#define FAULT_STALL_TIME_SEC         0.5
+/* DC bus over and under voltage set and clear levels in volts and the time
+   beyond the set level */
+#define FAULT_OVERVOLTAGE_SET        400.0
+#define FAULT_OVERVOLTAGE_CLEAR      380.0
+#define FAULT_UNDERVOLTAGE_SET       200.0
+#define FAULT_UNDERVOLTAGE_CLEAR     220.0
+#define FAULT_VOLTAGE_TIME_SEC       0.001
+/* Reactions - FAULT_REACTION_COAST or FAULT_REACTION_BRAKE. The brake 
+   stops regeneration into the DC bus */
+#define FAULT_OVERCURRENT_REACTION   FAULT_REACTION_COAST
+#define FAULT_PHASE_LOSS_REACTION    FAULT_REACTION_COAST
+#define FAULT_STALL_REACTION         FAULT_REACTION_COAST
+#define FAULT_OVERVOLTAGE_REACTION   FAULT_REACTION_BRAKE
+#define FAULT_UNDERVOLTAGE_REACTION  FAULT_REACTION_COAST
+/* Time the low side switches are on for the brake reaction */
+#define FAULT_BRAKE_TIME_SEC         1.0
+
+/* Restart policy constants */
+/* Restarts after consecutive trips of a fault class before the fault is 
+   latched, 0 latches it at the first trip, and the delay before the first 
+   restart. The hardware class is the trip of the overcurrent comparator */
+#define FAULT_OVERCURRENT_RESTARTS      0
+#define FAULT_OVERCURRENT_RESTART_SEC   5.0
+#define FAULT_STALL_RESTARTS            4
+#define FAULT_STALL_RESTART_SEC         1.0
+#define FAULT_PHASE_LOSS_RESTARTS       0
+#define FAULT_PHASE_LOSS_RESTART_SEC    5.0
+#define FAULT_OVERVOLTAGE_RESTARTS      3
+#define FAULT_OVERVOLTAGE_RESTART_SEC   2.0
+#define FAULT_UNDERVOLTAGE_RESTARTS     8
+#define FAULT_UNDERVOLTAGE_RESTART_SEC  1.0
+#define FAULT_HARDWARE_RESTARTS         1
+#define FAULT_HARDWARE_RESTART_SEC      5.0
+/* The restart delay is multiplied by 2^FAULT_RESTART_BACKOFF_SHIFT with every
+   consecutive restart of the class and limited to FAULT_RESTART_DELAY_MAX_SEC */
+#define FAULT_RESTART_BACKOFF_SHIFT     1
+#define FAULT_RESTART_DELAY_MAX_SEC     60.0
+/* Time running without faults after which the consecutive restarts are 
+   counted again */
+#define FAULT_RESTART_CLEAR_SEC         10.0
+/* The drive is locked out until it is started by the user after 
+   FAULT_LOCKOUT_TRIPS trips of any class within FAULT_LOCKOUT_WINDOW_SEC */
+#define FAULT_LOCKOUT_TRIPS             6
+#define FAULT_LOCKOUT_WINDOW_SEC        600
+
+/* Controlled stop constants */
+/* Deceleration time from the maximum speed to standstill, also the longest
+   time before the final stage starts */
+#define BRAKE_DECEL_TIME_SEC         0.2
+/* Speed where the final stage starts, in rpm */
+#define BRAKE_FINAL_SPEED_RPM        END_SPEED_RPM
+/* Final stage, BRAKE_SHORT_CIRCUIT or BRAKE_DC_INJECTION, and its duration.
+   The DC injection holds the rotor, it brakes only at low speeds */
+#define BRAKE_FINAL_STAGE            BRAKE_SHORT_CIRCUIT
+#define BRAKE_FINAL_TIME_SEC         0.08
+/* DC injection current in amps */
+#define BRAKE_DC_CURRENT             1.5
+/* Bus voltages in volts, at least 5 volts apart, at which the regenerative 
+   current starts to be reduced and is fully blocked, below the overvoltage
+   fault level */
+#define BRAKE_REGEN_LIMIT_START      360.0
+#define BRAKE_REGEN_LIMIT_END        385.0
+/* Bus voltages in volts at which the brake chopper is switched on and off */
+#define BRAKE_CHOPPER_ON             375.0
+#define BRAKE_CHOPPER_OFF            365.0
+
+/* MTPA constants */
+/* d and q axis inductances in henries of the interior permanent magnet
+   motor, MOTOR_LQ must be larger than MOTOR_LD. The magnet flux linkage is
+   the one the estimator uses, so that the MTPA d current matches the back
+   EMF constant NORM_INVKFIBASE */
+#define MOTOR_LD                     0.004
+#define MOTOR_LQ                     0.010
+#define MOTOR_FLUX_LINKAGE           NORM_FLUX_LINKAGE
+/* Output voltage magnitude relative to the voltage base above which the 
+   field is weakened, below the limit of the current controllers */
+#define MTPA_FW_VOLTAGE              0.93
+/* Field weakening integral gain, d current change per control cycle relative
+   to the squared voltage error */
+#define MTPA_FW_KI                   0.0012
+/* Largest negative d current of the field weakening in amps */
+#define MTPA_FW_CURRENT_MAX          2.5
+
+/* Efficiency optimization constants */
+/* q current in amps below which the d current offset is searched */
+#define EFFICIENCY_LOAD_CURRENT      1.0
+/* d current step and largest d current offset in amps */
+#define EFFICIENCY_ID_STEP           0.05
+#define EFFICIENCY_ID_MAX            0.5
+/* Settling time of the speed controller after each d current step */
+#define EFFICIENCY_SETTLE_TIME_SEC   0.3
+/* The input power is averaged over 2^EFFICIENCY_WINDOW_SHIFT control cycles,
+   up to 15 */
+#define EFFICIENCY_WINDOW_SHIFT      13
+/* Smallest decrease of the mean input power taken as an improvement, 
+   relative to the product of the voltage and current bases */
+#define EFFICIENCY_POWER_DEADBAND    0.0001
+/* Direction reversals after which the offset with the lowest power is held */
+#define EFFICIENCY_REVERSALS         3
+/* Speed reference change in rpm which restarts the search */
+#define EFFICIENCY_SPEED_BAND_RPM    20
+
+/* Power metering constants */
+/* Cut off frequency in Hz of the filtered power and torque */
+#define METER_FILTER_HZ              10.0
+
+/* Control mode constants */
+/* Newton meters of one unit of ctrlModeParm.torqueRef */
+#define CTRL_MODE_TORQUE_UNIT_NM     0.001
+/* Largest change of the q current reference in the torque modes, in amps 
+   per second */
+#define CTRL_MODE_TORQUE_SLEW        50.0
+
 /* Specify Over Current Limit - DC BUS */
+#ifdef THERMAL_PROTECTION
+/* Above the overload current allowed by the thermal protection */
+#define Q15_OVER_CURRENT_THRESHOLD NORM_CURRENT(THERMAL_OVERLOAD_CURRENT + 0.5)
+#else
 #define Q15_OVER_CURRENT_THRESHOLD NORM_CURRENT(3.5)
+#endif
 
 /* Maximum motor speed converted into electrical speed */
 #define MAXIMUMSPEED_ELECTR MAXIMUM_SPEED_RPM*POLE_PAIRS
@@ -202,7 +716,12 @@ minimum value accepted */
 #define SPEEDREFRAMP_COUNT   2  
     
 /* Maximum Speed PI controller output*/
+#ifdef THERMAL_PROTECTION
+/* The thermal protection reduces the limit to the rated current */
+#define SPEED_PI_OUT_MAX    (THERMAL_OVERLOAD_CURRENT/NORM_CURRENT_CONST)
+#else
 #define SPEED_PI_OUT_MAX    (MOTOR_RATED_PEAK_CURRENT/NORM_CURRENT_CONST)
+#endif
 /* PI controllers tuning values - */     
 /* D Control Loop Coefficients */
 #define D_CURRCNTR_PTERM       Q15(0.05)
@@ -221,6 +740,71 @@ minimum value accepted */
 #define SPEEDCNTR_ITERM        Q15(0.001)
 #define SPEEDCNTR_CTERM        Q15(0.999)
 #define SPEEDCNTR_OUTMAX       SPEED_PI_OUT_MAX
+
+/* S-curve speed reference constants */
+/* Acceleration limits for increasing and decreasing speed magnitude, 
+   relative to the linear ramp SPEEDREFRAMP per SPEEDREFRAMP_COUNT + 1 
+   control cycles, up to 7.99 */
+#define SPEED_RAMP_ACCEL        1.0
+#define SPEED_RAMP_DECEL        1.0
+/* Time from zero to the linear ramp acceleration, sets the jerk limit, in 
+   milliseconds, an integer so that its range can be checked */
+#define SPEED_RAMP_JERK_TIME_MSEC 100
+#if (SPEED_RAMP_JERK_TIME_MSEC < 1) || (SPEED_RAMP_JERK_TIME_MSEC > 409)
+    #error "SPEED_RAMP_JERK_TIME_MSEC must be in the range 1 to 409"
+#endif
+/* Iq reference above which the time optimal mode reduces the acceleration */
+#define SPEED_RAMP_CURRENT_LIMIT (int16_t)(SPEEDCNTR_OUTMAX*0.9)
+/* Reduction and recovery of the acceleration limits per control cycle, 
+   and the smallest scaling of the limits */
+#define SPEED_RAMP_SCALE_DOWN   Q15(0.001)
+#define SPEED_RAMP_SCALE_UP     Q15(0.0001)
+#define SPEED_RAMP_SCALE_MIN    Q15(0.05)
+
+/* Resonance notch filter constants */
+/* Number of notch filters in cascade, 1 or 2 */
+#define NOTCH_FILTER_COUNT      1
+/* Centre frequencies in Hz, the first one is the initial value when the 
+   frequency is adapted */
+#define NOTCH1_FREQUENCY_HZ     180
+#define NOTCH2_FREQUENCY_HZ     360
+/* Quality factor, centre frequency over the -3dB bandwidth */
+#define NOTCH_QUALITY           2.0
+/* Attenuation at the centre frequency, 1.0 for full suppression */
+#define NOTCH_DEPTH             1.0
+/* Frequency range of the resonance detection in Hz, below 1250Hz */
+#define NOTCH_DETECT_MIN_HZ     100
+#define NOTCH_DETECT_MAX_HZ     400
+/* Smallest Iq oscillation amplitude taken as a resonance */
+#define NOTCH_DETECT_AMPLITUDE  NORM_CURRENT(0.05)
+
+/* Speed controller gain scheduling constants */
+/* Number of table points, equally spaced from 0 to MAXIMUM_SPEED_RPM */
+#define SPEED_GAIN_TABLE_SIZE   5
+/* Proportional gains at 0, 1250, 2500, 3750 and 5000 RPM */
+#define SPEED_GAIN_KP0          Q15(0.05)
+#define SPEED_GAIN_KP1          Q15(0.05)
+#define SPEED_GAIN_KP2          Q15(0.05)
+#define SPEED_GAIN_KP3          Q15(0.05)
+#define SPEED_GAIN_KP4          Q15(0.05)
+/* Integral gains at 0, 1250, 2500, 3750 and 5000 RPM */
+#define SPEED_GAIN_KI0          Q15(0.001)
+#define SPEED_GAIN_KI1          Q15(0.001)
+#define SPEED_GAIN_KI2          Q15(0.001)
+#define SPEED_GAIN_KI3          Q15(0.001)
+#define SPEED_GAIN_KI4          Q15(0.001)
+/* Iq accelerating the inertia the table is tuned for at the ramp rate 
+   SPEEDREFRAMP per SPEEDREFRAMP_COUNT + 1 control cycles, must be above 
+   NORM_CURRENT(0.18) */
+#define SPEED_ACCEL_CURRENT     NORM_CURRENT(0.5)
+/* Inertia at power up and its limits, relative to the tuned inertia */
+#define SPEED_INERTIA_INIT      1.0
+#define SPEED_INERTIA_MIN       0.25
+#define SPEED_INERTIA_MAX       7.99
+/* Filter constant of the inertia estimation */
+#define SPEED_INERTIA_FILTER    Q15(0.0005)
+/* Filter constant of the load current estimation */
+#define SPEED_LOAD_FILTER       Q15(0.001)
  
 /******************************** Field Weakening *****************************/
 /* Field Weakening constant for constant torque range 